@@ -13,8 +13,27 @@
 #include <string_view>
 #include <filesystem>
 #include <chrono>
+#include <random>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <memory_resource>
+#include <deque>
+#include <algorithm>
+#include <mutex>
+#include <thread>
+#include <atomic>
 #include <August++/ParseDocument.hpp>
 #include <August++/StringifyDocument.hpp>
+#include <August++/ParseTape.hpp>
+#include <August++/ParseCursor.hpp>
+#include <August++/ParsePointer.hpp>
+#include <August++/ParseBinding.hpp>
+#include <August++/ParseKeySet.hpp>
+#include <August++/ParseFile.hpp>
+#include <August++/ParseEvents.hpp>
+#include <August++/ParseChunks.hpp>
+#include <August++/ParseLines.hpp>
 using namespace std;
 using namespace August;
 
@@ -96,6 +115,1572 @@ static bool TestReadingWithNativeJsonFiles(const char* executable)
 	return success;
 }
 
+static std::vector<Character> ReadFile(const filesystem::path& path)
+{
+	auto size = std::filesystem::file_size(path);
+	std::vector<Character> content(static_cast<std::size_t>(size) + 1);
+	std::ifstream file(path.string(), std::ios::in | std::ios::binary);
+	file.read(reinterpret_cast<char*>(content.data()), static_cast<std::streamsize>(size));
+	file.close();
+	content[static_cast<std::size_t>(size)] = 0;
+	return content;
+}
+
+// Deep comparison of two parsed values
+static bool SameTokens(const ParseToken& a, const ParseToken& b)
+{
+	if (a.IsNull() || b.IsNull())
+		return a.IsNull() && b.IsNull();
+	if (a.IsBoolean() || b.IsBoolean())
+		return a.IsBoolean() && b.IsBoolean() && a.As<bool>() == b.As<bool>();
+	if (a.IsUnsignedInteger() || b.IsUnsignedInteger())
+		return a.IsUnsignedInteger() && b.IsUnsignedInteger() && a.As<std::uint64_t>() == b.As<std::uint64_t>();
+	if (a.IsInteger() || b.IsInteger())
+		return a.IsInteger() && b.IsInteger() && a.As<std::int64_t>() == b.As<std::int64_t>();
+	if (a.IsFloatingPoint() || b.IsFloatingPoint())
+		return a.IsFloatingPoint() && b.IsFloatingPoint() && a.As<double>() == b.As<double>();
+	if (a.IsArray() || b.IsArray())
+	{
+		if (!a.IsArray() || !b.IsArray())
+			return false;
+		auto& arrayA = a.As<ParseArray>();
+		auto& arrayB = b.As<ParseArray>();
+		if (arrayA.size() != arrayB.size())
+			return false;
+		for (std::size_t i = 0; i < arrayA.size(); i++)
+			if (!SameTokens(arrayA[i], arrayB[i]))
+				return false;
+		return true;
+	}
+	if (a.IsObject() || b.IsObject())
+	{
+		if (!a.IsObject() || !b.IsObject())
+			return false;
+		auto& objectA = a.As<ParseObject>();
+		auto& objectB = b.As<ParseObject>();
+		if (objectA.size() != objectB.size())
+			return false;
+		for (auto& member : objectA)
+		{
+			auto found = objectB.find(member.first);
+			if (found == objectB.end() || !SameTokens(member.second, found->second))
+				return false;
+		}
+		return true;
+	}
+	return a.As<StringView>() == b.As<StringView>();
+}
+
+// Deep comparison of a parsed value with the same value from a tape
+static bool SameTokens(const ParseToken& a, const TapeValue& b)
+{
+	if (a.IsNull() || b.IsNull())
+		return a.IsNull() && b.IsNull();
+	if (a.IsBoolean() || b.IsBoolean())
+		return a.IsBoolean() && b.IsBoolean() && a.As<bool>() == b.As<bool>();
+	if (a.IsUnsignedInteger() || b.IsUnsignedInteger())
+		return a.IsUnsignedInteger() && b.IsUnsignedInteger() && a.As<std::uint64_t>() == b.As<std::uint64_t>();
+	if (a.IsInteger() || b.IsInteger())
+		return a.IsInteger() && b.IsInteger() && a.As<std::int64_t>() == b.As<std::int64_t>();
+	if (a.IsFloatingPoint() || b.IsFloatingPoint())
+		return a.IsFloatingPoint() && b.IsFloatingPoint() && a.As<double>() == b.As<double>();
+	if (a.IsArray() || b.IsArray())
+	{
+		if (!a.IsArray() || !b.IsArray())
+			return false;
+		auto& arrayA = a.As<ParseArray>();
+		auto arrayB = b.As<TapeArray>();
+		if (arrayA.size() != arrayB.size())
+			return false;
+		auto elementB = arrayB.begin();
+		for (auto& elementA : arrayA)
+			if (!SameTokens(elementA, *elementB++))
+				return false;
+		return elementB == arrayB.end();
+	}
+	if (a.IsObject() || b.IsObject())
+	{
+		if (!a.IsObject() || !b.IsObject())
+			return false;
+		auto& objectA = a.As<ParseObject>();
+		auto objectB = b.As<TapeObject>();
+		if (objectA.size() != objectB.size())
+			return false;
+		for (auto& member : objectA)
+		{
+			auto found = objectB.find(member.first);
+			if (found == objectB.end() || !SameTokens(member.second, (*found).second))
+				return false;
+		}
+		return true;
+	}
+	return a.As<StringView>() == b.As<StringView>();
+}
+
+// Walks the whole of the cursor's value, so every part of it is read
+static bool SameTokens(const ParseToken& a, const ValueCursor& b)
+{
+	if (a.IsArray() || b.IsArray())
+	{
+		if (!a.IsArray() || !b.IsArray())
+			return false;
+		auto& arrayA = a.As<ParseArray>();
+		auto elementA = arrayA.begin();
+		for (auto elementB : b.As<ArrayCursor>())
+			if (elementA == arrayA.end() || !SameTokens(*elementA++, elementB))
+				return false;
+		return elementA == arrayA.end();
+	}
+	if (a.IsObject() || b.IsObject())
+	{
+		if (!a.IsObject() || !b.IsObject())
+			return false;
+		auto& objectA = a.As<ParseObject>();
+		auto memberA = objectA.begin();
+		for (auto memberB : b.As<ObjectCursor>())
+		{
+			if (memberA == objectA.end() || memberA->first != memberB.first || !SameTokens(memberA->second, memberB.second))
+				return false;
+			++memberA;
+		}
+		return memberA == objectA.end();
+	}
+	return SameTokens(a, b.Token());
+}
+
+// Parse each file the regular way and with an alternative, and expect identical results or identical errors
+template<class Alternative_>
+static bool TestReadingMatchesRegular(const char* executable, const char* description, Alternative_ alternative)
+{
+	auto success = true;
+	for (auto folder : { "JSON_checker/test-files", "nativejson-benchmark" })
+	{
+		for (const auto& entry : filesystem::directory_iterator(GetPathToTestFiles(executable) / folder))
+		{
+			auto regularContent = ReadFile(entry.path());
+			// Padded so alternatives can also try the length delimited form
+			auto alternativeContent = regularContent;
+			alternativeContent.resize(regularContent.size() - 1 + ParsePadding);
+			std::unique_ptr<ParseDocument> regular;
+			decltype(alternative(nullptr)) other;
+			std::ptrdiff_t regularError = -1, otherError = -1;
+
+			auto start = std::chrono::high_resolution_clock::now();
+			try
+			{
+				regular = std::make_unique<ParseDocument>(regularContent.data());
+			}
+			catch (const ParseException& error)
+			{
+				regularError = error.Where - regularContent.data();
+			}
+			auto middle = std::chrono::high_resolution_clock::now();
+			try
+			{
+				other = alternative(alternativeContent.data());
+			}
+			catch (const ParseException& error)
+			{
+				otherError = error.Where - alternativeContent.data();
+			}
+			auto end = std::chrono::high_resolution_clock::now();
+
+			if (regularError != otherError || (regular && !SameTokens(*regular, *other)))
+			{
+				cout << "** " << description << " differs for " << entry.path().string() << " **" << endl;
+				success = false;
+			}
+			else if (string_view(folder) == "nativejson-benchmark")
+			{
+				cout << entry.path().string() << " regular " << std::chrono::duration_cast<std::chrono::microseconds>(middle - start).count() <<
+					"us, " << description << " " << std::chrono::duration_cast<std::chrono::microseconds>(end - middle).count() << "us" << endl;
+			}
+		}
+	}
+	return success;
+}
+
+static bool TestReadingWithStack(const char* executable)
+{
+	ParseStack stack;
+	auto success = TestReadingMatchesRegular(executable, "stack", [&](ParseIterator content)
+	{
+		return std::make_unique<ParseDocument>(content, stack);
+	});
+
+	// Far deeper than recursion could manage, then beyond the maximum depth
+	for (auto depth : { 100000, 100001 })
+	{
+		ParseStack deepStack(100000);
+		std::vector<Character> content(depth, '[');
+		content.insert(content.end(), depth, ']');
+		content.push_back(0);
+		try
+		{
+			ParseDocument document(content.data(), deepStack);
+			if (depth != 100000 || !document.IsArray())
+				success = false;
+		}
+		catch (const ParseException& error)
+		{
+			if (depth == 100000 || error.Where != content.data() + 100000)
+				success = false;
+		}
+	}
+	return success;
+}
+
+static bool TestReadingWithProjection(const char* executable)
+{
+	auto success = true;
+
+	// A few fields of every status, against the same read from the whole document
+	auto regularContent = ReadFile(GetPathToTestFiles(executable) / "nativejson-benchmark" / "twitter.json");
+	auto projectedContent = regularContent;
+	auto start = std::chrono::high_resolution_clock::now();
+	ParseDocument regular(regularContent.data());
+	auto middle = std::chrono::high_resolution_clock::now();
+	ParseProjection projection{ u8"statuses[*].user.id"sv, u8"statuses[*].entities.hashtags[*].text"sv, u8"search_metadata.count"sv };
+	ParseDocument projected(projectedContent.data(), projection);
+	auto end = std::chrono::high_resolution_clock::now();
+	auto size = [](const ParseToken* token)
+	{
+		return !token ? std::size_t(-1) : token->IsObject() ? token->As<ParseObject>().size() : token->IsArray() ? token->As<ParseArray>().size() : 0;
+	};
+	auto same = [&](const Character* pointer)
+	{
+		JsonPointer path{ StringView(pointer) };
+		auto a = path.Find(regular), b = path.Find(projected);
+		return a && b && SameTokens(*a, *b);
+	};
+	auto statuses = size(JsonPointer(u8"/statuses"sv).Find(regular));
+	if (size(&projected) != 2 || size(JsonPointer(u8"/search_metadata"sv).Find(projected)) != 1 || !same(u8"/search_metadata/count") ||
+		size(JsonPointer(u8"/statuses"sv).Find(projected)) != statuses || statuses != 100)
+		success = false;
+	for (std::size_t i = 0; success && i < statuses; i++)
+	{
+		auto status = u8"/statuses/" + Stringified(reinterpret_cast<const Character*>(std::to_string(i).c_str()));
+		auto hashtags = size(JsonPointer(status + u8"/entities/hashtags").Find(regular));
+		if (size(JsonPointer(status).Find(projected)) != 2 || size(JsonPointer(status + u8"/user").Find(projected)) != 1 ||
+			!same((status + u8"/user/id").c_str()) || size(JsonPointer(status + u8"/entities/hashtags").Find(projected)) != hashtags)
+			success = false;
+		for (std::size_t j = 0; success && j < hashtags; j++)
+		{
+			auto hashtag = status + u8"/entities/hashtags/" + Stringified(reinterpret_cast<const Character*>(std::to_string(j).c_str()));
+			if (size(JsonPointer(hashtag).Find(projected)) != 1 || !same((hashtag + u8"/text").c_str()))
+				success = false;
+		}
+	}
+	cout << "twitter.json regular " << std::chrono::duration_cast<std::chrono::microseconds>(middle - start).count() <<
+		"us, projection " << std::chrono::duration_cast<std::chrono::microseconds>(end - middle).count() << "us" << endl;
+
+	// Values of the wrong kind are left out, the first of duplicates is taken, and the rest of a complete object isn't looked at
+	Stringified text = u8"{\"a\":{\"b\":[{\"c\":1,\"d\":2},3,{\"d\":4},{\"c\":[\"\\u0041\"]}],\"x\":1e999},\"s\":\"\\\"}\",\"a\":0,\"n\":{\"n\":5,\"n\":6,\"z\":[}},\"e\":7} trailing";
+	std::vector<Character> content(text.begin(), text.end());
+	content.push_back(0);
+	ParseProjection small{ u8"a.b[*].c"sv, u8"n.n"sv, u8"e"sv, u8"n.n"sv };
+	ParseDocument document(content.data(), small);
+	auto find = [&](StringView pointer)
+	{
+		return JsonPointer(pointer).Find(document);
+	};
+	if (size(&document) != 3 || size(find(u8"/a"sv)) != 1 || size(find(u8"/a/b"sv)) != 3 || size(find(u8"/a/b/0"sv)) != 1 ||
+		find(u8"/a/b/0/c"sv)->As<int>() != 1 || size(find(u8"/a/b/1"sv)) != 0 || find(u8"/a/b/2/c/0"sv)->As<StringView>() != u8"A"sv ||
+		size(find(u8"/n"sv)) != 1 || find(u8"/n/n"sv)->As<int>() != 5 || find(u8"/e"sv)->As<int>() != 7)
+		success = false;
+
+	// Duplicates are left out however many members are requested, beyond those tracked for stopping early
+	{
+		ParseProjection many;
+		Stringified manyText = u8"{";
+		for (auto member = 0; member < 70; member++)
+		{
+			auto name = u8"m" + Stringified(reinterpret_cast<const Character*>(std::to_string(member).c_str()));
+			many.Add(name);
+			manyText += u8"\"" + name + u8"\":" + Stringified(reinterpret_cast<const Character*>(std::to_string(member).c_str())) + u8",";
+		}
+		manyText += u8"\"m68\":-1,\"m3\":-1}";
+		std::vector<Character> manyContent(manyText.begin(), manyText.end());
+		manyContent.push_back(0);
+		ParseDocument manyDocument(manyContent.data(), many);
+		auto& projectedMany = manyDocument.As<ParseObject>();
+		if (projectedMany.size() != 70 || projectedMany[u8"m68"sv].As<int>() != 68 || projectedMany[u8"m3"sv].As<int>() != 3)
+			success = false;
+	}
+
+	// Errors still found in the values kept, and the nesting of those stepped over
+	for (auto invalid : { u8"{\"e\":1x}"sv, u8"{\"a\":[}"sv, u8"{\"a\":,\"e\":1}"sv, u8"{\"e\":1"sv })
+	{
+		std::vector<Character> bad(invalid.begin(), invalid.end());
+		bad.push_back(0);
+		try
+		{
+			ParseDocument failed(bad.data(), small);
+			success = false;
+		}
+		catch (const ParseException&)
+		{
+		}
+	}
+	for (auto path : { u8""sv, u8"a."sv, u8".a"sv, u8"a[0]"sv, u8"a[*]b"sv, u8"a..b"sv })
+	{
+		try
+		{
+			ParseProjection invalid{ path };
+			success = false;
+		}
+		catch (const ParseException&)
+		{
+		}
+	}
+	if (!success)
+		cout << "** reading with a projection failed **" << endl;
+	return success;
+}
+
+// Parts of twitter.json, bound to plain structs
+struct BoundHashtag
+{
+	Stringified Text;
+	std::vector<int> Indices;
+};
+template<> struct August::ParseBinding<BoundHashtag>
+{
+	static constexpr auto Fields = std::make_tuple(BindField(u8"text"sv, &BoundHashtag::Text), BindField(u8"indices"sv, &BoundHashtag::Indices));
+};
+
+struct BoundUser
+{
+	std::int64_t Id;
+	StringView ScreenName;
+	bool Verified;
+};
+template<> struct August::ParseBinding<BoundUser>
+{
+	static constexpr auto Fields = std::make_tuple(BindField(u8"id"sv, &BoundUser::Id), BindField(u8"screen_name"sv, &BoundUser::ScreenName),
+		BindField(u8"verified"sv, &BoundUser::Verified));
+};
+
+struct BoundEntities
+{
+	std::vector<BoundHashtag> Hashtags;
+};
+template<> struct August::ParseBinding<BoundEntities>
+{
+	static constexpr auto Fields = std::make_tuple(BindField(u8"hashtags"sv, &BoundEntities::Hashtags));
+};
+struct BoundTweet
+{
+	std::uint64_t Id;
+	StringView Text;
+	BoundUser User;
+	BoundEntities Entities;
+	std::optional<std::int64_t> InReplyTo;
+	double RetweetCount;
+};
+template<> struct August::ParseBinding<BoundTweet>
+{
+	static constexpr auto Fields = std::make_tuple(BindField(u8"id"sv, &BoundTweet::Id), BindField(u8"text"sv, &BoundTweet::Text),
+		BindField(u8"user"sv, &BoundTweet::User), BindField(u8"entities"sv, &BoundTweet::Entities),
+		BindField(u8"in_reply_to_status_id"sv, &BoundTweet::InReplyTo), BindField(u8"retweet_count"sv, &BoundTweet::RetweetCount));
+};
+struct BoundSearch
+{
+	std::vector<BoundTweet> Statuses;
+};
+template<> struct August::ParseBinding<BoundSearch>
+{
+	static constexpr auto Fields = std::make_tuple(BindField(u8"statuses"sv, &BoundSearch::Statuses));
+};
+
+struct BoundSmall
+{
+	int Small;
+	std::optional<bool> Flag;
+	std::vector<std::vector<double>> Grid;
+	std::optional<std::vector<bool>> Switches;
+};
+template<> struct August::ParseBinding<BoundSmall>
+{
+	static constexpr auto Fields = std::make_tuple(BindField(u8"small"sv, &BoundSmall::Small), BindField(u8"flag"sv, &BoundSmall::Flag),
+		BindField(u8"grid"sv, &BoundSmall::Grid), BindField(u8"switches"sv, &BoundSmall::Switches));
+};
+
+// Names that differ only in the middle
+struct BoundNames
+{
+	StringView UserA;
+	StringView UserB;
+};
+template<> struct August::ParseBinding<BoundNames>
+{
+	static constexpr auto Fields = std::make_tuple(BindField(u8"user_a_name"sv, &BoundNames::UserA), BindField(u8"user_b_name"sv, &BoundNames::UserB));
+};
+
+static bool TestReadingWithBinding(const char* executable)
+{
+	auto success = true;
+
+	// Every bound field of every status, against the same read from the whole document
+	auto regularContent = ReadFile(GetPathToTestFiles(executable) / "nativejson-benchmark" / "twitter.json");
+	auto boundContent = regularContent;
+	auto start = std::chrono::high_resolution_clock::now();
+	ParseDocument regular(regularContent.data());
+	auto middle = std::chrono::high_resolution_clock::now();
+	BoundSearch search;
+	ParseInto(boundContent.data(), search);
+	auto end = std::chrono::high_resolution_clock::now();
+	auto& statuses = JsonPointer(u8"/statuses"sv).Find(regular)->As<ParseArray>();
+	if (search.Statuses.size() != statuses.size())
+		success = false;
+	for (std::size_t i = 0; success && i < statuses.size(); i++)
+	{
+		auto& status = statuses[i].As<ParseObject>();
+		auto& tweet = search.Statuses[i];
+		auto& user = status[u8"user"sv].As<ParseObject>();
+		auto& reply = status[u8"in_reply_to_status_id"sv];
+		if (tweet.Id != status[u8"id"sv].As<std::uint64_t>() || tweet.Text != status[u8"text"sv].As<StringView>() ||
+			tweet.User.Id != user[u8"id"sv].As<std::int64_t>() || tweet.User.ScreenName != user[u8"screen_name"sv].As<StringView>() ||
+			tweet.User.Verified != user[u8"verified"sv].As<bool>() || tweet.RetweetCount != status[u8"retweet_count"sv].As<double>() ||
+			tweet.InReplyTo.has_value() == reply.IsNull() || (tweet.InReplyTo && *tweet.InReplyTo != reply.As<std::int64_t>()))
+			success = false;
+		auto& hashtags = status[u8"entities"sv].As<ParseObject>()[u8"hashtags"sv].As<ParseArray>();
+		if (tweet.Entities.Hashtags.size() != hashtags.size())
+			success = false;
+		for (std::size_t j = 0; success && j < hashtags.size(); j++)
+		{
+			auto& hashtag = hashtags[j].As<ParseObject>();
+			auto& indices = hashtag[u8"indices"sv].As<ParseArray>();
+			if (tweet.Entities.Hashtags[j].Text != hashtag[u8"text"sv].As<StringView>() || tweet.Entities.Hashtags[j].Indices.size() != indices.size() ||
+				tweet.Entities.Hashtags[j].Indices[0] != indices[0].As<int>() || tweet.Entities.Hashtags[j].Indices[1] != indices[1].As<int>())
+				success = false;
+		}
+	}
+	cout << "twitter.json regular " << std::chrono::duration_cast<std::chrono::microseconds>(middle - start).count() <<
+		"us, binding " << std::chrono::duration_cast<std::chrono::microseconds>(end - middle).count() << "us" << endl;
+
+	// Members not bound are stepped over, the first of duplicates is taken, and missing optional members are left empty
+	auto parse = [](StringView text, BoundSmall& small)
+	{
+		std::vector<Character> content(text.begin(), text.end());
+		content.push_back(0);
+		ParseInto(content.data(), small);
+	};
+	BoundSmall small;
+	small.Flag = true;
+	parse(u8" {\"other\":{\"a\":[1,\"]\"]},\"grid\":[[1,2.5],[],[-3e2]],\"small\":-7,\"small\":8} "sv, small);
+	if (small.Small != -7 || small.Flag || small.Grid.size() != 3 || small.Grid[0].size() != 2 || small.Grid[0][1] != 2.5 ||
+		!small.Grid[1].empty() || small.Grid[2][0] != -300)
+		success = false;
+	parse(u8"{\"small\":2147483647,\"flag\":false,\"grid\":[],\"switches\":[true,false,true]}"sv, small);
+	if (small.Small != 2147483647 || !small.Flag || *small.Flag || !small.Grid.empty() || small.Switches != std::vector<bool>{ true, false, true })
+		success = false;
+	parse(u8"{\"small\":0,\"flag\":null,\"grid\":[]}"sv, small);
+	if (small.Flag || small.Switches)
+		success = false;
+	Stringified namesText = u8"{\"user_b_name\":\"b\",\"user_c_name\":\"c\",\"user_a_name\":\"a\"}";
+	std::vector<Character> namesContent(namesText.begin(), namesText.end());
+	namesContent.push_back(0);
+	BoundNames names;
+	ParseInto(namesContent.data(), names);
+	if (names.UserA != u8"a"sv || names.UserB != u8"b"sv)
+		success = false;
+
+	// Errors point at the value, or the end of the object for a missing member
+	for (auto invalid : { u8"{\"flag\":true,\"grid\":[]}"sv, u8"{\"small\":1.5,\"grid\":[]}"sv, u8"{\"small\":2147483648,\"grid\":[]}"sv,
+		u8"{\"small\":\"1\",\"grid\":[]}"sv, u8"{\"small\":1,\"grid\":[1]}"sv, u8"{\"small\":1,\"flag\":1,\"grid\":[]}"sv,
+		u8"{\"small\":1,\"grid\":[]} x"sv, u8"{\"small\":1,\"grid\":[],\"switches\":[true,0]}"sv, u8"[]"sv })
+	{
+		try
+		{
+			parse(invalid, small);
+			success = false;
+		}
+		catch (const ParseException&)
+		{
+		}
+	}
+	if (!success)
+		cout << "** reading with a binding failed **" << endl;
+	return success;
+}
+
+static bool TestReadingInParallel(const char* executable)
+{
+	// Parts of any size, so that even the small test files are split wherever they can be
+	ParseParallel parallel(4, 1);
+	auto success = TestReadingMatchesRegular(executable, "parallel", [&](ParseIterator content)
+	{
+		return std::make_unique<ParseDocument>(content, parallel);
+	});
+
+	// Elements whose strings hold what would otherwise be taken for structure, then errors within and after the array
+	Stringified text = u8"[";
+	for (auto element = 0; element < 20000; element++)
+	{
+		auto number = std::to_string(element);
+		text += element ? u8",\n " : u8"";
+		text += u8"{\"n\":";
+		text.append(number.begin(), number.end());
+		text += u8",\"s\":\"],[{,\\\"\\\\\",\"a\":[[1,2],{\"b\":[]}]}";
+	}
+	text += u8"]";
+	auto invalid = text;
+	invalid.replace(invalid.find(u8"\"n\":10000,"), 10, u8"\"n\":1x000,");
+	auto trailing = text + u8" [";
+	for (auto variant : { &text, &invalid, &trailing })
+	{
+		std::vector<Character> regularContent(variant->begin(), variant->end());
+		regularContent.push_back(0);
+		auto parallelContent = regularContent;
+		std::ptrdiff_t regularError = -1, parallelError = -1;
+		std::unique_ptr<ParseDocument> regular, other;
+		try
+		{
+			regular = std::make_unique<ParseDocument>(regularContent.data());
+		}
+		catch (const ParseException& error)
+		{
+			regularError = error.Where - regularContent.data();
+		}
+		try
+		{
+			other = std::make_unique<ParseDocument>(parallelContent.data(), parallel);
+		}
+		catch (const ParseException& error)
+		{
+			parallelError = error.Where - parallelContent.data();
+		}
+		if (regularError != parallelError || (regular && !SameTokens(*regular, *other)) || (variant == &text) != !!regular)
+			success = false;
+	}
+
+	// The test files all have objects at their root, so aren't split. Time a large root array with the default part size
+	// and a thread for each core, the case parallel parsing is for. At least two, so it's split even with a single core.
+	Stringified large = u8"[";
+	for (auto copy = 0; copy < 10; copy++)
+		large.append(text, 1, text.size() - 2).append(copy < 9 ? u8"," : u8"]");
+	std::vector<Character> regularContent(large.begin(), large.end());
+	regularContent.push_back(0);
+	auto parallelContent = regularContent;
+	ParseParallel cores(std::max(std::thread::hardware_concurrency(), 2u));
+	auto start = std::chrono::high_resolution_clock::now();
+	ParseDocument regular(regularContent.data());
+	auto middle = std::chrono::high_resolution_clock::now();
+	ParseDocument other(parallelContent.data(), cores);
+	auto end = std::chrono::high_resolution_clock::now();
+	if (!SameTokens(regular, other) || other.As<ParseArray>().size() != 200000)
+		success = false;
+	cout << "root array of " << large.size() / 1024 << "KB regular " << std::chrono::duration_cast<std::chrono::microseconds>(middle - start).count() <<
+		"us, parallel on " << cores.Threads() << " threads " << std::chrono::duration_cast<std::chrono::microseconds>(end - middle).count() << "us" << endl;
+	if (!success)
+		cout << "** reading in parallel failed **" << endl;
+	return success;
+}
+
+static bool TestReadingWithLength(const char* executable)
+{
+	auto success = TestReadingMatchesRegular(executable, "length", [](ParseIterator content)
+	{
+		// Fill the padding with anything but a terminator
+		auto length = std::strlen(reinterpret_cast<const char*>(content));
+		std::memset(content + length, '{', ParsePadding);
+		return std::make_unique<ParseDocument>(content, length);
+	});
+
+	// A zero byte is only an end when it's at the length
+	for (auto test : { std::make_pair("[1,2]"sv, true), std::make_pair("[1,2]  "sv, true), std::make_pair("[1,2]\0 "sv, false),
+		std::make_pair("[1,\0 2]"sv, false), std::make_pair("\"a\0\""sv, false) })
+	{
+		// Padding that would carry on the document if it were read
+		std::vector<Character> content(test.first.size() + ParsePadding, '1');
+		std::memcpy(content.data(), test.first.data(), test.first.size());
+		try
+		{
+			ParseDocument document(content.data(), test.first.size());
+			if (!test.second || document.As<ParseArray>().size() != 2)
+				success = false;
+		}
+		catch (const ParseException&)
+		{
+			if (test.second)
+				success = false;
+		}
+	}
+	return success;
+}
+
+static bool TestReadingReadOnly(const char* executable)
+{
+	auto unchanged = true;
+	auto success = TestReadingMatchesRegular(executable, "read only", [&](ParseIterator content)
+	{
+		// The source must be left exactly as it was
+		std::vector<Character> original(content, content + std::strlen(reinterpret_cast<const char*>(content)) + 1);
+		auto document = std::make_unique<ParseDocument>(ReadOnly, content);
+		if (!std::equal(original.begin(), original.end(), content))
+			unchanged = false;
+		return document;
+	}) && unchanged;
+
+	// Only chosen by name, so a const pointer alone doesn't quietly take the slower path
+	static_assert(!std::is_constructible<ParseDocument, const Character*>::value, "A const buffer needs August::ReadOnly");
+
+	// A literal is in read only memory, so any write would fault
+	static const Character text[] = u8"{\"plain\":\"text\",\"na\\u006de\":[\"\\\"\\\\\\/\\b\\f\\n\\r\\t\",\"\\u00e9\\u20ac\\u0041\"]}";
+	ParseDocument document(ReadOnly, text);
+	auto& object = document.As<ParseObject>();
+	auto plain = object[u8"plain"sv].As<StringView>();
+	if (plain != u8"text"sv || plain.data() < text || plain.data() >= text + sizeof(text))
+		success = false;
+	auto& array = object[u8"name"sv].As<ParseArray>();
+	if (array[0].As<StringView>() != u8"\"\\/\b\f\n\r\t"sv || array[1].As<ParseString>() != u8"\u00e9\u20acA"sv)
+		success = false;
+
+	// Which decodes just as the in place parse does
+	std::vector<Character> content(text, text + sizeof(text));
+	ParseDocument inPlace(content.data());
+	if (!SameTokens(document, inPlace))
+		success = false;
+	return success;
+}
+
+static bool TestReadingFromFile(const char* executable)
+{
+	auto success = true;
+	for (auto folder : { "JSON_checker/test-files", "nativejson-benchmark" })
+	{
+		for (const auto& entry : filesystem::directory_iterator(GetPathToTestFiles(executable) / folder))
+		{
+			auto content = ReadFile(entry.path());
+			std::unique_ptr<ParseDocument> regular;
+			std::unique_ptr<ParseFile> mapped;
+			try
+			{
+				regular = std::make_unique<ParseDocument>(content.data());
+			}
+			catch (const ParseException&)
+			{
+			}
+			try
+			{
+				mapped = std::make_unique<ParseFile>(entry.path());
+			}
+			catch (const ParseException&)
+			{
+			}
+			if (!regular != !mapped || (regular && !SameTokens(*regular, *mapped)))
+			{
+				cout << "** file differs for " << entry.path().string() << " **" << endl;
+				success = false;
+			}
+		}
+	}
+
+	// A file filling whole pages still gets its terminator
+	auto path = filesystem::temp_directory_path() / "August++PageSized.json";
+	{
+		std::ofstream file(path, std::ios::out | std::ios::binary);
+		file << '[' << std::string(65534, ' ') << ']';
+	}
+	try
+	{
+		ParseFile file(path);
+		if (!file.IsArray() || !file.As<ParseArray>().empty())
+			success = false;
+	}
+	catch (const exception&)
+	{
+		success = false;
+	}
+	filesystem::remove(path);
+
+	try
+	{
+		ParseFile file(path);
+		success = false;
+	}
+	catch (const std::system_error&)
+	{
+	}
+	return success;
+}
+
+// Every event in order, with the key or value where there is one
+struct RecordedEvent
+{
+	char Kind;
+	StringView Key;
+	ParseToken Value;
+};
+
+struct RecordingHandler
+{
+	std::vector<RecordedEvent> Events;
+
+	void StartObject() { Events.push_back(RecordedEvent{ '{', {}, {} }); }
+	void Key(StringView name) { Events.push_back(RecordedEvent{ 'k', name, {} }); }
+	void EndObject() { Events.push_back(RecordedEvent{ '}', {}, {} }); }
+	void StartArray() { Events.push_back(RecordedEvent{ '[', {}, {} }); }
+	void EndArray() { Events.push_back(RecordedEvent{ ']', {}, {} }); }
+	void Value(const ParseToken& value) { Events.push_back(RecordedEvent{ 'v', {}, ParseToken(value) }); }
+
+	// The events a parsed document would have given
+	void Walk(const ParseToken& token)
+	{
+		if (token.IsObject())
+		{
+			StartObject();
+			for (auto& member : token.As<ParseObject>())
+			{
+				Key(member.first);
+				Walk(member.second);
+			}
+			EndObject();
+		}
+		else if (token.IsArray())
+		{
+			StartArray();
+			for (auto& element : token.As<ParseArray>())
+				Walk(element);
+			EndArray();
+		}
+		else
+			Value(token);
+	}
+};
+
+static bool SameEvents(const RecordingHandler& a, const RecordingHandler& b)
+{
+	if (a.Events.size() != b.Events.size())
+		return false;
+	for (std::size_t i = 0; i < a.Events.size(); i++)
+	{
+		auto& x = a.Events[i];
+		auto& y = b.Events[i];
+		if (x.Kind != y.Kind || x.Key != y.Key || (x.Kind == 'v' && !SameTokens(x.Value, y.Value)))
+			return false;
+	}
+	return true;
+}
+
+static bool TestReadingWithEvents(const char* executable)
+{
+	auto success = true;
+	for (auto folder : { "JSON_checker/test-files", "nativejson-benchmark" })
+	{
+		for (const auto& entry : filesystem::directory_iterator(GetPathToTestFiles(executable) / folder))
+		{
+			auto regularContent = ReadFile(entry.path());
+			auto eventsContent = regularContent;
+			std::unique_ptr<ParseDocument> regular;
+			std::ptrdiff_t regularError = -1, eventsError = -1;
+			RecordingHandler walked, handler;
+			try
+			{
+				regular = std::make_unique<ParseDocument>(regularContent.data());
+				walked.Walk(*regular);
+			}
+			catch (const ParseException& error)
+			{
+				regularError = error.Where - regularContent.data();
+			}
+			try
+			{
+				ParseEvents events(eventsContent.data(), handler);
+			}
+			catch (const ParseException& error)
+			{
+				eventsError = error.Where - eventsContent.data();
+			}
+
+			if (regularError != eventsError || (regular && !SameEvents(walked, handler)))
+			{
+				cout << "** events differ for " << entry.path().string() << " **" << endl;
+				success = false;
+			}
+		}
+	}
+	return success;
+}
+
+// Strings passed by ParseChunks don't outlast the call, so are kept
+struct CopyingHandler : RecordingHandler
+{
+	std::deque<Stringified> Strings;
+
+	void Key(StringView name) { RecordingHandler::Key(Strings.emplace_back(name)); }
+	void Value(const ParseToken& value)
+	{
+		if (value.IsString())
+		{
+			auto& copy = Strings.emplace_back(value.As<StringView>());
+			RecordingHandler::Value(ParseToken(copy.data(), copy.size()));
+		}
+		else
+			RecordingHandler::Value(value);
+	}
+};
+
+static bool TestReadingWithChunks(const char* executable)
+{
+	auto success = true;
+	std::mt19937 random(1);
+	for (auto folder : { "JSON_checker/test-files", "nativejson-benchmark" })
+	{
+		for (const auto& entry : filesystem::directory_iterator(GetPathToTestFiles(executable) / folder))
+		{
+			auto content = ReadFile(entry.path());
+			auto size = content.size() - 1;
+			std::unique_ptr<ParseDocument> regular;
+			std::ptrdiff_t regularError = -1;
+			RecordingHandler walked;
+			{
+				auto regularContent = content;
+				try
+				{
+					regular = std::make_unique<ParseDocument>(regularContent.data());
+					walked.Walk(*regular);
+				}
+				catch (const ParseException& error)
+				{
+					regularError = error.Where - regularContent.data();
+				}
+
+				// Single characters, awkward sizes that split every kind of token somewhere, then random sizes
+				for (std::size_t chunkSize : { std::size_t(1), std::size_t(3), std::size_t(7), std::size_t(4096), std::size_t(0) })
+				{
+					CopyingHandler handler;
+					ParseChunks chunks(handler);
+					std::ptrdiff_t chunksError = -1;
+					try
+					{
+						for (std::size_t offset = 0; offset < size;)
+						{
+							auto length = std::min(size - offset, chunkSize ? chunkSize : std::size_t(random() % 100 + 1));
+							// Each chunk is its own copy that's gone once fed
+							std::vector<Character> chunk(content.begin() + offset, content.begin() + offset + length);
+							chunks.Feed(chunk.data(), chunk.size());
+							offset += length;
+						}
+						chunks.Finish();
+					}
+					catch (const ParseException&)
+					{
+						chunksError = static_cast<std::ptrdiff_t>(chunks.Position());
+					}
+					if (regularError != chunksError || (regular && !SameEvents(walked, handler)))
+					{
+						cout << "** chunks of " << chunkSize << " differ for " << entry.path().string() << " **" << endl;
+						success = false;
+					}
+				}
+			}
+		}
+	}
+
+	// A zero within a chunk is content like any other, so can't follow the root value
+	for (auto text : { u8"{}\0"sv, u8"12\0"sv, u8"[1] \0 "sv })
+	{
+		CopyingHandler handler;
+		ParseChunks chunks(handler);
+		try
+		{
+			chunks.Feed(text.data(), text.size());
+			chunks.Finish();
+			success = false;
+		}
+		catch (const ParseException&)
+		{
+			if (chunks.Position() != text.find(Character(0)))
+				success = false;
+		}
+	}
+	if (!success)
+		cout << "** reading in chunks failed **" << endl;
+	return success;
+}
+
+// Records numbered by line, with blank lines, a carriage return and escapes along the way
+static std::vector<Character> MakeLines(std::size_t count, std::size_t invalidLine)
+{
+	Stringified text;
+	for (std::size_t line = 0; line < count; line++)
+	{
+		auto number = std::to_string(line);
+		if (line == invalidLine)
+			text += u8"{\"line\":}";
+		else if (line % 7 == 3)
+			text += u8"  ";
+		else
+		{
+			text += u8"{\"line\":";
+			text.append(number.begin(), number.end());
+			text += line % 5 ? u8",\"name\":\"a\\nb\",\"list\":[1,2,{\"x\":null}]}" : u8"\r";
+			if (line % 5 == 0)
+				text.insert(text.size() - 1, u8"}");
+		}
+		if (line + 1 != count)
+			text += u8"\n";
+	}
+	std::vector<Character> content(text.begin(), text.end());
+	content.resize(text.size() + ParsePadding);
+	return content;
+}
+
+static bool TestReadingLines()
+{
+	auto success = true;
+	constexpr std::size_t count = 20000;
+	for (std::size_t threads : { 1, 4 })
+	{
+		ParseLines lines(threads);
+
+		// In order, every record given once and the line numbers counting the blank lines
+		auto content = MakeLines(count, count);
+		std::size_t expected = 0;
+		lines.Parse(content.data(), content.size() - ParsePadding, [&](std::size_t line, ParseDocument& record)
+		{
+			while (expected % 7 == 3)
+				expected++;
+			auto& object = record.As<ParseObject>();
+			if (line != expected || object[u8"line"sv].As<std::size_t>() != line || (line % 5 && object[u8"name"sv].As<StringView>() != u8"a\nb"sv))
+				success = false;
+			expected++;
+		});
+		if (expected != count)
+			success = false;
+
+		// Unordered, every record given once
+		content = MakeLines(count, count);
+		std::mutex mutex;
+		std::vector<bool> seen(count);
+		lines.Parse(content.data(), content.size() - ParsePadding, [&](std::size_t line, ParseDocument& record)
+		{
+			auto number = record.As<ParseObject>()[u8"line"sv].As<std::size_t>();
+			std::lock_guard<std::mutex> lock(mutex);
+			if (number != line || seen[line])
+				success = false;
+			seen[line] = true;
+		}, LineOrder::Unordered);
+		for (std::size_t line = 0; line < count; line++)
+		{
+			if (seen[line] == (line % 7 == 3))
+				success = false;
+		}
+
+		// Every record before an error is given in order, then the error is thrown at the invalid record
+		auto invalidLine = count / 2;
+		content = MakeLines(count, invalidLine);
+		std::size_t given = 0;
+		try
+		{
+			lines.Parse(content.data(), content.size() - ParsePadding, [&](std::size_t line, ParseDocument&)
+			{
+				if (line >= invalidLine)
+					success = false;
+				given++;
+			});
+			success = false;
+		}
+		catch (const ParseException& error)
+		{
+			// The line feeds have become terminators, so the invalid record is found in an untouched copy
+			auto original = MakeLines(count, invalidLine);
+			auto invalid = u8"{\"line\":}"sv;
+			auto record = std::search(original.begin(), original.end(), invalid.begin(), invalid.end()) - original.begin();
+			if (error.Where - content.data() != record + 8)
+				success = false;
+		}
+		if (given != invalidLine - invalidLine / 7 - (invalidLine % 7 > 3 ? 1 : 0))
+			success = false;
+	}
+	if (!success)
+		cout << "** reading lines failed **" << endl;
+	return success;
+}
+
+static bool TestReadingWithLazyNumbers(const char* executable)
+{
+	auto success = TestReadingMatchesRegular(executable, "lazy numbers", [](ParseIterator content)
+	{
+		return std::make_unique<ParseDocument>(content, ParseOptions::LazyNumbers);
+	});
+
+	// The text is kept exactly, so precision beyond the native types isn't lost
+	Stringified text = u8"[123456789012345678901234567890,0.10000000000000000000001,-4,9223372036854775807,9223372036854775808,-9223372036854775809]";
+	std::vector<Character> content(text.begin(), text.end());
+	content.push_back(0);
+	ParseDocument document(content.data(), ParseOptions::LazyNumbers);
+	auto& array = document.As<ParseArray>();
+	// Integers are classified as the regular parse would, so one too large for any integer type is floating point
+	if (array[0].AsText() != u8"123456789012345678901234567890"sv || array[0].IsInteger() || !array[0].IsFloatingPoint() || array[0].As<double>() != 123456789012345678901234567890.0)
+		success = false;
+	if (!array[3].IsInteger() || array[4].IsInteger() || !array[4].IsUnsignedInteger() || array[4].IsFloatingPoint() || !array[5].IsFloatingPoint())
+		success = false;
+	if (array[1].AsText() != u8"0.10000000000000000000001"sv || !array[1].IsFloatingPoint() || array[1].As<double>() != 0.1)
+		success = false;
+	if (array[2].As<int>() != -4)
+		success = false;
+	return success;
+}
+
+static bool TestReadingWithTape(const char* executable)
+{
+	auto success = TestReadingMatchesRegular(executable, "tape", [](ParseIterator content)
+	{
+		return std::make_unique<TapeDocument>(content);
+	});
+
+	// Members and elements are kept in document order
+	Stringified text = u8"{\"b\":[1,{\"c\":[]},\"x\"],\"a\":true,\"d\":{}}";
+	std::vector<Character> content(text.begin(), text.end());
+	content.push_back(0);
+	TapeDocument document(content.data());
+	auto object = document.As<TapeObject>();
+	auto member = object.begin();
+	if (object.size() != 3 || (*member).first != u8"b"sv || (*++member).first != u8"a"sv || (*++member).first != u8"d"sv || ++member != object.end())
+		success = false;
+	auto array = object[u8"b"sv].As<TapeArray>();
+	if (array.size() != 3 || array[0].As<int>() != 1 || !array[1].As<TapeObject>()[u8"c"sv].As<TapeArray>().empty() || array[2].As<StringView>() != u8"x"sv)
+		success = false;
+	if (!object[u8"a"sv].As<bool>() || !object[u8"d"sv].As<TapeObject>().empty() || document.TapeSize() != 12)
+		success = false;
+	try
+	{
+		object[u8"e"sv];
+		success = false;
+	}
+	catch (const std::out_of_range&)
+	{
+	}
+
+	// Arrays holding no containers are indexed directly, and others by stepping over the elements before
+	Stringified arraysText = u8"[[3,\"y\",null,4.5],[[1,2],{\"z\":[]},7]]";
+	std::vector<Character> arraysContent(arraysText.begin(), arraysText.end());
+	arraysContent.push_back(0);
+	TapeDocument arrays(arraysContent.data());
+	auto scalars = arrays.As<TapeArray>()[0].As<TapeArray>();
+	auto containers = arrays.As<TapeArray>()[1].As<TapeArray>();
+	if (scalars[0].As<int>() != 3 || scalars[1].As<StringView>() != u8"y"sv || !scalars[2].IsNull() || scalars[3].As<double>() != 4.5 ||
+		containers[0].As<TapeArray>()[1].As<int>() != 2 || !containers[1].IsObject() || containers[2].As<int>() != 7)
+		success = false;
+	return success;
+}
+
+// Forwards to the heap, keeping count of what's outstanding
+class CountingResource : public std::pmr::memory_resource
+{
+	void* do_allocate(std::size_t bytes, std::size_t alignment) override
+	{
+		Allocations++;
+		Outstanding += bytes;
+		return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+	}
+	void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override
+	{
+		Outstanding -= bytes;
+		std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+	}
+	bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+	{
+		return this == &other;
+	}
+public:
+	std::size_t Allocations = 0;
+	std::size_t Outstanding = 0;
+};
+
+static bool TestReadingWithCursor(const char* executable)
+{
+	auto success = true;
+	for (auto folder : { "JSON_checker/test-files", "nativejson-benchmark" })
+	{
+		for (const auto& entry : filesystem::directory_iterator(GetPathToTestFiles(executable) / folder))
+		{
+			auto regularContent = ReadFile(entry.path());
+			const auto cursorContent = regularContent;
+			std::unique_ptr<ParseDocument> regular;
+			try
+			{
+				regular = std::make_unique<ParseDocument>(regularContent.data());
+			}
+			catch (const ParseException&)
+			{
+			}
+			// Only what's read is checked, so a walk of an invalid document needn't fail
+			try
+			{
+				DocumentCursor cursor(cursorContent.data());
+				if (regular && !SameTokens(*regular, cursor))
+				{
+					cout << "** cursor differs for " << entry.path().string() << " **" << endl;
+					success = false;
+				}
+			}
+			catch (const exception&)
+			{
+				if (regular)
+				{
+					cout << "** cursor failed for " << entry.path().string() << " **" << endl;
+					success = false;
+				}
+			}
+		}
+	}
+
+	// Members are found past values that are never interpreted, numbers stepped over aren't converted,
+	// and escapes are decoded only for what's read
+	Stringified text = u8"{\"skip\":{\"s\":\"]}\\\"\",\"t\":[{},[1e999]]},\"number\":-01x,\"a\\u0041\":\"x\\ny\",\"n\":[1,2.5,true,null],\"e\":[1,2 3]}";
+	std::vector<Character> content(text.begin(), text.end());
+	content.push_back(0);
+	DocumentCursor cursor(content.data());
+	if (cursor[u8"aA"sv].As<StringView>() != u8"x\ny"sv || cursor[u8"n"sv][1].As<double>() != 2.5 || !cursor[u8"n"sv][2].As<bool>() ||
+		!cursor[u8"n"sv][3].IsNull() || cursor[u8"n"sv].As<ArrayCursor>().size() != 4 || !cursor[u8"e"sv].IsArray())
+		success = false;
+	if (Stringified(content.begin(), content.end() - 1) != text)
+		success = false;
+
+	// Searches pass escaped names without decoding them, and what's read is only kept once however often it's read again
+	{
+		CountingResource counting;
+		DocumentCursor counted(content.data(), &counting);
+		auto read = [&]
+		{
+			auto object = counted.As<ObjectCursor>();
+			auto same = counted[u8"n"sv][0].As<int>() == 1 && counted[u8"aA"sv].As<StringView>() == u8"x\ny"sv &&
+				object.find(u8"a"sv) == object.end() && object.find(u8"aAA"sv) == object.end() && object.find(u8"aB"sv) == object.end();
+			for (auto member : counted.As<ObjectCursor>())
+				if (member.first == u8"aA"sv && !member.second.IsString())
+					same = false;
+			return same;
+		};
+		if (!read())
+			success = false;
+		auto outstanding = counting.Outstanding;
+		for (auto repeat = 0; repeat < 100; repeat++)
+			if (!read())
+				success = false;
+		if (counting.Outstanding != outstanding)
+			success = false;
+	}
+	try
+	{
+		cursor[u8"missing"sv];
+		success = false;
+	}
+	catch (const std::out_of_range&)
+	{
+	}
+	try
+	{
+		cursor[u8"n"sv][4];
+		success = false;
+	}
+	catch (const std::out_of_range&)
+	{
+	}
+	try
+	{
+		cursor[u8"e"sv][2];
+		success = false;
+	}
+	catch (const ParseException& error)
+	{
+		if (error.Where != content.data() + text.find(u8"3]"))
+			success = false;
+	}
+	if (!success)
+		cout << "** reading with a cursor failed **" << endl;
+	return success;
+}
+
+static bool TestReadingWithKeySet()
+{
+	// Names alike in length and bytes, resolved at compile time
+	static constexpr ParseKeySet keys{ u8"id"sv, u8"di"sv, u8"name"sv, u8"nome"sv, u8""sv, u8"price"sv, u8"prices"sv, u8"aXa"sv, u8"aYa"sv };
+	static_assert(keys.Find(u8"name"sv) == 2 && keys.Find(u8"nome"sv) == 3 && keys.Find(u8"aYa"sv) == 8, "Key set lookup");
+	static_assert(keys.Find(u8"nam"sv) == keys.NoMatch && keys.Find(u8"aZa"sv) == keys.NoMatch, "Key set miss");
+
+	auto success = true;
+	for (std::size_t i = 0; i < keys.size(); i++)
+		if (keys.Find(keys[i]) != i)
+			success = false;
+	for (auto other : { u8"Id"sv, u8"i"sv, u8"idd"sv, u8"price "sv, u8"pricee"sv, u8"aaa"sv })
+		if (keys.Find(other) != keys.NoMatch)
+			success = false;
+
+	// Dispatching on the members of a parsed object
+	Stringified text = u8"{\"price\":2.5,\"other\":1,\"id\":7,\"na\\u006de\":\"x\",\"\":true}";
+	std::vector<Character> content(text.begin(), text.end());
+	content.push_back(0);
+	ParseDocument document(content.data());
+	int seen = 0;
+	for (auto& member : document.As<ParseObject>())
+	{
+		switch (keys.Find(member.first))
+		{
+		case 0:
+			seen += member.second.As<int>() == 7 ? 1 : 100;
+			break;
+		case 2:
+			seen += member.second.As<StringView>() == u8"x"sv ? 10 : 100;
+			break;
+		case 4:
+			seen += member.second.As<bool>() ? 1000 : 100;
+			break;
+		case 5:
+			seen += member.second.As<double>() == 2.5 ? 10000 : 100;
+			break;
+		case keys.NoMatch:
+			seen += member.first == u8"other"sv ? 100000 : 100;
+			break;
+		default:
+			seen += 100;
+		}
+	}
+	if (seen != 111011)
+		success = false;
+
+	// Names alike in length and in every byte near either end are hashed whole
+	static constexpr ParseKeySet middles{ u8"user_a_name"sv, u8"user_b_name"sv, u8"user_c_name"sv };
+	static_assert(middles.Find(u8"user_b_name"sv) == 1 && middles.Find(u8"user_d_name"sv) == middles.NoMatch, "Key set hashing whole names");
+
+	// Too many names for any perfect hash to be likely, so they're probed for
+	std::array<Stringified, 600> texts;
+	std::array<StringView, 600> many;
+	for (std::size_t i = 0; i < many.size(); i++)
+	{
+		auto number = std::to_string(i);
+		texts[i] = u8"m" + Stringified(number.begin(), number.end());
+		many[i] = texts[i];
+	}
+	auto probed = std::apply([](auto... names) { return ParseKeySet<sizeof...(names)>(names...); }, many);
+	for (std::size_t i = 0; i < many.size(); i++)
+		if (probed.Find(many[i]) != i)
+			success = false;
+	for (auto other : { u8"m600"sv, u8"m"sv, u8"n0"sv, u8""sv })
+		if (probed.Find(other) != probed.NoMatch)
+			success = false;
+
+	// Only duplicates can't be told apart
+	try
+	{
+		ParseKeySet duplicates{ u8"a"sv, u8"b"sv, u8"a"sv };
+		success = false;
+	}
+	catch (const std::invalid_argument&)
+	{
+	}
+	if (!success)
+		cout << "** reading with a key set failed **" << endl;
+	return success;
+}
+
+static bool TestReadingWithPointer()
+{
+	// The examples of RFC 6901, along with enough members for the hashed lookup
+	Stringified text = u8"{\"foo\":[\"bar\",\"baz\"],\"\":0,\"a/b\":1,\"c%d\":2,\"e^f\":3,\"g|h\":4,\"i\\\\j\":5,\"k\\\"l\":6,\" \":7,\"m~n\":8,"
+		u8"\"0\":{\"1\":[[true]]},\"p\":9,\"q\":10,\"r\":11,\"s\":12,\"t\":13,\"u\":14,\"v\":15,\"w\":16,\"x\":17,\"y\":18,\"z\":19}";
+	std::vector<Character> content(text.begin(), text.end());
+	content.push_back(0);
+	ParseDocument document(content.data());
+	auto success = true;
+	if (JsonPointer(u8""sv).Find(document) != &document || JsonPointer(u8"/foo"sv).Find(document)->As<ParseArray>().size() != 2 ||
+		JsonPointer(u8"/foo/0"sv).Find(document)->As<StringView>() != u8"bar"sv || !JsonPointer(u8"/0/1/0/0"sv).Find(document)->As<bool>())
+		success = false;
+	int expected = 0;
+	for (auto pointer : { u8"/"sv, u8"/a~1b"sv, u8"/c%d"sv, u8"/e^f"sv, u8"/g|h"sv, u8"/i\\j"sv, u8"/k\"l"sv, u8"/ "sv, u8"/m~0n"sv, u8"/p"sv, u8"/z"sv })
+	{
+		auto found = JsonPointer(pointer).Find(document);
+		if (!found || found->As<int>() != expected)
+			success = false;
+		expected = expected == 8 ? 9 : expected == 9 ? 19 : expected + 1;
+	}
+
+	// Misses are null rather than exceptions
+	for (auto pointer : { u8"/foo/2"sv, u8"/foo/-"sv, u8"/foo/01"sv, u8"/foo/bar"sv, u8"/nope"sv, u8"/foo/0/x"sv, u8"/p/0"sv, u8"/0/2"sv })
+		if (JsonPointer(pointer).Find(document))
+			success = false;
+
+	for (auto pointer : { u8"foo"sv, u8"/a~2"sv, u8"/a~"sv })
+	{
+		try
+		{
+			JsonPointer invalid(pointer);
+			success = false;
+		}
+		catch (const ParseException&)
+		{
+		}
+	}
+	if (!success)
+		cout << "** reading with a pointer failed **" << endl;
+	return success;
+}
+
+static bool TestReadingWithMemoryResource(const char* executable)
+{
+	CountingResource counting;
+	std::pmr::monotonic_buffer_resource arena(&counting);
+	auto success = TestReadingMatchesRegular(executable, "memory resource", [&](ParseIterator content)
+	{
+		// The previous document has already gone, so its storage can all be dropped at once
+		arena.release();
+
+		// Nothing should fall back to the default resource, so make that fail loudly whilst parsing
+		struct NoDefaultResource
+		{
+			std::pmr::memory_resource* Previous = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+			~NoDefaultResource()
+			{
+				std::pmr::set_default_resource(Previous);
+			}
+		} noDefaultResource;
+		return std::make_unique<ParseDocument>(content, ParseOptions::None, &arena);
+	});
+	arena.release();
+	if (counting.Allocations == 0 || counting.Outstanding != 0)
+		success = false;
+
+	// Without an arena everything is handed back when the document goes
+	Stringified text = u8"{\"a\":[1,2,{\"b\":[]}],\"c\":{\"d\":null}}";
+	std::vector<Character> content(text.begin(), text.end());
+	content.push_back(0);
+	{
+		ParseDocument document(content.data(), ParseOptions::None, &counting);
+		if (counting.Outstanding == 0 || document.As<ParseObject>()[u8"a"sv].As<ParseArray>().size() != 3)
+			success = false;
+	}
+	if (counting.Outstanding != 0)
+		success = false;
+	return success;
+}
+
+static bool TestReadingWithPackedNumbers(const char* executable)
+{
+	auto success = TestReadingMatchesRegular(executable, "packed numbers", [](ParseIterator content)
+	{
+		return std::make_unique<ParseDocument>(content, ParseOptions::PackedNumbers);
+	});
+
+	// The coordinates of canada.json are pairs of doubles, taking far less memory packed
+	auto regularContent = ReadFile(GetPathToTestFiles(executable) / "nativejson-benchmark" / "canada.json");
+	auto packedContent = regularContent;
+	CountingResource regularMemory, packedMemory;
+	ParseDocument regular(regularContent.data(), ParseOptions::None, &regularMemory);
+	ParseDocument packed(packedContent.data(), ParseOptions::PackedNumbers, &packedMemory);
+	auto* coordinates = JsonPointer(u8"/features/0/geometry/coordinates/0/0"sv).Find(packed);
+	if (!coordinates || !coordinates->IsPackedFloatingPoints() || coordinates->As<PackedNumbers<double>>().size() != 2 ||
+		coordinates->As<PackedNumbers<double>>()[0] != JsonPointer(u8"/features/0/geometry/coordinates/0/0/0"sv).Find(regular)->As<double>() ||
+		packedMemory.Outstanding * 3 > regularMemory.Outstanding * 2)
+		success = false;
+	cout << "canada.json regular " << regularMemory.Outstanding << " bytes, packed numbers " << packedMemory.Outstanding << " bytes" << endl;
+
+	// Only arrays of numbers all of one type are packed, so every element keeps its type
+	Stringified text = u8"[[1,2],[1,2.5],[-3,4],[0.5,-1e3],[1,\"x\"],[18446744073709551615],[],[1 , 2 ],{\"a\":[7]}]";
+	std::vector<Character> content(text.begin(), text.end());
+	content.push_back(0);
+	ParseDocument document(content.data(), ParseOptions::PackedNumbers);
+	auto& array = document.As<ParseArray>();
+	auto integers = array[2].As<PackedNumbers<std::int64_t>>();
+	auto floatingPoints = array[3].As<PackedNumbers<double>>();
+	if (document.IsPackedIntegers() || !array[0].IsPackedIntegers() || array[1].IsPacked() || !array[2].IsPackedIntegers() ||
+		integers.size() != 2 || integers[0] != -3 || integers[1] != 4 || floatingPoints[0] != 0.5 || floatingPoints[1] != -1000 ||
+		array[4].IsPacked() || array[5].IsPacked() || array[6].IsPacked() || !array[7].IsPackedIntegers() ||
+		!array[8].As<ParseObject>()[u8"a"sv].IsPackedIntegers())
+		success = false;
+	if (!array[1].As<ParseArray>()[0].IsInteger() || array[1].As<ParseArray>()[1].As<double>() != 2.5 || array[2].As<ParseArray>()[1].As<int>() != 4 || array[7].As<ParseArray>().size() != 2)
+		success = false;
+	try
+	{
+		array[0].As<PackedNumbers<double>>();
+		success = false;
+	}
+	catch (const std::bad_cast&)
+	{
+	}
+
+	// Reading packed arrays as a ParseArray from several threads makes only the tokens of those read
+	{
+		auto threadedContent = ReadFile(GetPathToTestFiles(executable) / "nativejson-benchmark" / "canada.json");
+		std::pmr::monotonic_buffer_resource resource;
+		ParseDocument points(threadedContent.data(), ParseOptions::PackedNumbers, &resource);
+		auto& coordinatesArray = JsonPointer(u8"/features/0/geometry/coordinates/0"sv).Find(points)->As<ParseArray>();
+		std::atomic<bool> same{ true };
+		std::vector<std::thread> threads;
+		for (auto thread = 0; thread < 4; thread++)
+			threads.emplace_back([&, thread]
+			{
+				for (auto point = std::size_t(thread); point < coordinatesArray.size(); point += 2)
+					if (coordinatesArray[point].As<ParseArray>()[1].As<double>() != coordinatesArray[point].As<PackedNumbers<double>>()[1])
+						same = false;
+			});
+		for (auto& thread : threads)
+			thread.join();
+		if (!same)
+			success = false;
+	}
+
+	// Each part of a parallel parse packs its own arrays
+	Stringified points = u8"[";
+	for (auto point = 0; point < 1000; point++)
+	{
+		auto number = std::to_string(point);
+		points += point ? u8",[" : u8"[";
+		points.append(number.begin(), number.end());
+		points += u8",2]";
+	}
+	points += u8"]";
+	std::vector<Character> pointsContent(points.begin(), points.end());
+	pointsContent.push_back(0);
+	ParseParallel parallel(4, 1);
+	ParseDocument parallelDocument(pointsContent.data(), parallel, ParseOptions::PackedNumbers);
+	auto& parallelPoints = parallelDocument.As<ParseArray>();
+	for (std::size_t point = 0; point < parallelPoints.size(); point++)
+		if (!parallelPoints[point].IsPackedIntegers() || parallelPoints[point].As<PackedNumbers<std::int64_t>>()[0] != static_cast<std::int64_t>(point))
+			success = false;
+
+	// Lazy numbers keep their text instead
+	std::vector<Character> lazy(text.begin(), text.end());
+	lazy.push_back(0);
+	ParseDocument lazyDocument(lazy.data(), ParseOptions::PackedNumbers | ParseOptions::LazyNumbers);
+	if (lazyDocument.As<ParseArray>()[0].IsPacked())
+		success = false;
+	if (!success)
+		cout << "** reading with packed numbers failed **" << endl;
+	return success;
+}
+
+static bool TestReparse(const char* executable)
+{
+	auto success = true;
+	auto source = ReadFile(GetPathToTestFiles(executable) / "nativejson-benchmark" / "twitter.json");
+	auto content = source;
+	CountingResource counting;
+	ParseDocument document(content.data(), ParseOptions::None, &counting);
+	auto statuses = document.As<ParseObject>()[u8"statuses"sv].As<ParseArray>().size();
+
+	// A different document in between shouldn't lose the capacity for the first
+	Stringified text = u8"[{\"a\":1},[true]]";
+	std::vector<Character> other(text.begin(), text.end());
+	other.push_back(0);
+	document.Reparse(other.data());
+	if (document.As<ParseArray>().size() != 2 || document.As<ParseArray>()[0].As<ParseObject>()[u8"a"sv].As<int>() != 1)
+		success = false;
+
+	// The same shape again is parsed without allocating
+	auto allocations = counting.Allocations;
+	content = source;
+	document.Reparse(content.data());
+	if (counting.Allocations != allocations || document.As<ParseObject>()[u8"statuses"sv].As<ParseArray>().size() != statuses)
+		success = false;
+
+	document.Clear();
+	if (!document.IsNull())
+		success = false;
+	return success;
+}
+
+// Rewrite a document without any whitespace outside of strings, or with a line per value and tab indentation
+static std::vector<Character> Reformat(const std::vector<Character>& content, bool pretty)
+{
+	std::vector<Character> reformatted;
+	reformatted.reserve(content.size() * 2);
+	auto newLine = [&](int indent)
+	{
+		reformatted.push_back('\n');
+		reformatted.insert(reformatted.end(), static_cast<std::size_t>(indent), '\t');
+	};
+	auto inString = false, escaped = false;
+	auto indent = 0;
+	for (auto character : content)
+	{
+		if (!character)
+			break;
+		if (inString)
+		{
+			reformatted.push_back(character);
+			if (escaped)
+				escaped = false;
+			else if (character == '\\')
+				escaped = true;
+			else if (character == '"')
+				inString = false;
+			continue;
+		}
+		switch (character)
+		{
+		case ' ': case '\t': case '\r': case '\n':
+			break;
+		case '{': case '[':
+			reformatted.push_back(character);
+			if (pretty)
+				newLine(++indent);
+			break;
+		case '}': case ']':
+			if (pretty)
+				newLine(--indent);
+			reformatted.push_back(character);
+			break;
+		case ',':
+			reformatted.push_back(character);
+			if (pretty)
+				newLine(indent);
+			break;
+		case ':':
+			reformatted.push_back(character);
+			if (pretty)
+				reformatted.push_back(' ');
+			break;
+		case '"':
+			inString = true;
+			reformatted.push_back(character);
+			break;
+		default:
+			reformatted.push_back(character);
+		}
+	}
+	reformatted.push_back(0);
+	return reformatted;
+}
+
+// Compare parse times of minified and pretty-printed versions of the same documents.
+// Whitespace skipping dominates the pretty-printed timings.
+static bool BenchmarkMinifiedAndPrettyPrinted(const char* executable)
+{
+	auto success = true;
+	for (const auto& entry : filesystem::directory_iterator(GetPathToTestFiles(executable) / "nativejson-benchmark"))
+	{
+		auto content = ReadFile(entry.path());
+		for (auto pretty : { false, true })
+		{
+			auto source = Reformat(content, pretty);
+			auto scratch = source;
+			// Best of a few runs. The parse modifies strings with escapes in-place, so start from a fresh copy each time.
+			auto best = std::chrono::high_resolution_clock::duration::max();
+			for (auto run = 0; run < 5; run++)
+			{
+				std::copy(source.begin(), source.end(), scratch.begin());
+				auto start = std::chrono::high_resolution_clock::now();
+				try
+				{
+					ParseDocument parseDocument(scratch.data());
+				}
+				catch (const exception&)
+				{
+					success = false;
+				}
+				best = std::min(best, std::chrono::high_resolution_clock::now() - start);
+			}
+			auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(best).count();
+			cout << entry.path().filename().string() << (pretty ? " pretty-printed " : " minified ") << source.size() << " bytes: " <<
+				microseconds << "us (" << (microseconds ? source.size() / static_cast<std::size_t>(microseconds) : 0) << "MB/s)" << endl;
+		}
+	}
+	return success;
+}
+
 static std::vector<Character> buffer;
 static std::unique_ptr<ParseDocument> parseDocument;
 
@@ -157,6 +1742,11 @@ static bool TestReadingBasicTypes()
 	// Strings
 	if (TestParseValue(u8"\"He\u0040llo\""sv).As<StringView>() != u8"He@llo"sv)
 		success = false;
+	// Unicode escapes take one byte below U+0080, two below U+0800 and three otherwise, with hex digits of either case
+	if (TestParseValue(u8"\"\\u0041\\u007f\\u00e9\\u00E9\\u07ff\\u0800\\u20ac\\u20AC\\uffff\""sv).As<StringView>() != u8"A\u007f\u00e9\u00e9\u07ff\u0800\u20ac\u20ac\uffff"sv)
+		success = false;
+	if (TestParseValue(u8"\"\\u00ab\\u00cd\\u00ef\\u00AB\\u00CD\\u00EF\""sv).As<StringView>() != u8"\u00ab\u00cd\u00ef\u00ab\u00cd\u00ef"sv)
+		success = false;
 
 	// ParseBoolean
 	if (!TestParseValue(u8"true"sv).As<bool>())
@@ -171,6 +1761,61 @@ static bool TestReadingBasicTypes()
 	if (object[u8"ParseObject"sv].As<ParseObject>()[u8"Text"sv].As<ParseString>() != u8"Hello"sv)
 		success = false;
 
+	// Members iterate in document order and the first of any duplicate names is found, with or without a hash index
+	for (auto members : { 3, 40 })
+	{
+		Stringified text = u8"{";
+		for (auto member = members; member > 0; member--)
+			text += u8"\"m" + Stringified(reinterpret_cast<const Character*>(std::to_string(member).c_str())) + u8"\":" + Stringified(reinterpret_cast<const Character*>(std::to_string(member).c_str())) + u8",";
+		text += u8"\"m1\":0}";
+		auto& ordered = TestParseValue(text).As<ParseObject>();
+		auto expected = members;
+		for (auto& member : ordered)
+			if (expected > 0 && member.second.As<int>() != expected--)
+				success = false;
+		if (ordered.size() != static_cast<std::size_t>(members) + 1 || ordered[u8"m1"sv].As<int>() != 1 || ordered[u8"m2"sv].As<int>() != 2 || ordered.find(u8"m0"sv) != ordered.end())
+			success = false;
+		static constexpr ParseKey m1(u8"m1"sv), m3(u8"m3"sv), m0(u8"m0"sv);
+		if (ordered[m1].As<int>() != 1 || ordered[m3].As<int>() != 3 || ordered.find(m0) != ordered.end())
+			success = false;
+		for (auto& member : ordered)
+			if (ordered.find(ParseKey(member.first)) != ordered.find(member.first))
+				success = false;
+	}
+
+	// Indexes are built while parsing, so lookups in different objects of a document from several threads don't
+	// allocate from its memory resource, here one that isn't thread safe
+	{
+		Stringified text = u8"[";
+		for (auto index = 0; index < 4; index++)
+		{
+			text += index ? u8",{" : u8"{";
+			for (auto member = 0; member < 40; member++)
+				text += (member ? u8",\"m" : u8"\"m") + Stringified(reinterpret_cast<const Character*>(std::to_string(member).c_str())) + u8"\":" +
+					Stringified(reinterpret_cast<const Character*>(std::to_string(index).c_str()));
+			text += u8"}";
+		}
+		text += u8"]";
+		std::vector<Character> content(text.begin(), text.end());
+		content.push_back(0);
+		std::pmr::monotonic_buffer_resource resource;
+		const ParseDocument document(content.data(), ParseOptions::None, &resource);
+		std::atomic<int> found{ 0 };
+		std::vector<std::thread> threads;
+		for (auto index = 0; index < 4; index++)
+			threads.emplace_back([&, index]
+			{
+				static constexpr ParseKey m39(u8"m39"sv);
+				auto& members = document.As<ParseArray>()[index].As<ParseObject>();
+				if (members[m39].As<int>() == index && members[u8"m7"sv].As<int>() == index)
+					found++;
+			});
+		for (auto& thread : threads)
+			thread.join();
+		if (found != 4)
+			success = false;
+	}
+
 	// ParseArray
 	auto& array = TestParseValue(u8"[43,\"Text\",true,[\"Hello\"]]"sv).As<ParseArray>();
 	if (array[0].As<int>() != 43)
@@ -188,6 +1833,115 @@ static bool TestReadingBasicTypes()
 	return success;
 }
 
+// Parse text and expect exactly the double that the C library gives
+static bool TestReadingDoubleMatchesStrtod(const char* text)
+{
+	auto expected = std::strtod(text, nullptr);
+	auto actual = TestParseValue(StringView(reinterpret_cast<const Character*>(text), std::strlen(text))).As<double>();
+	if (std::memcmp(&expected, &actual, sizeof(double)) != 0)
+	{
+		cout << "** Incorrectly rounded " << text << " **" << endl;
+		return false;
+	}
+	return true;
+}
+
+static bool TestReadingNumbers()
+{
+	auto success = true;
+
+	// Integers promote from signed to unsigned to floating point as their magnitude increases
+	if (TestParseValue(u8"9223372036854775807"sv).As<std::int64_t>() != std::numeric_limits<std::int64_t>::max())
+		success = false;
+	if (TestParseValue(u8"-9223372036854775808"sv).As<std::int64_t>() != std::numeric_limits<std::int64_t>::min())
+		success = false;
+	if (!TestParseValue(u8"9223372036854775808"sv).IsUnsignedInteger() || TestParseValue(u8"9223372036854775808"sv).As<std::uint64_t>() != 9223372036854775808u)
+		success = false;
+	// Only those readable as std::int64_t are IsInteger(), so checking it first keeps As<std::int64_t>() from throwing
+	if (!TestParseValue(u8"9223372036854775807"sv).IsInteger() || TestParseValue(u8"9223372036854775808"sv).IsInteger() || TestParseValue(u8"18446744073709551615"sv).IsInteger())
+		success = false;
+	if (TestParseValue(u8"18446744073709551615"sv).As<std::uint64_t>() != std::numeric_limits<std::uint64_t>::max())
+		success = false;
+	if (!TestParseValue(u8"18446744073709551616"sv).IsFloatingPoint() || TestParseValue(u8"18446744073709551616"sv).As<double>() != 18446744073709551616.0)
+		success = false;
+	if (TestParseValue(u8"-9223372036854775809"sv).As<double>() != -9223372036854775809.0)
+		success = false;
+	try
+	{
+		TestParseValue(u8"9223372036854775808"sv).As<std::int64_t>();
+		success = false;
+	}
+	catch (const std::bad_cast&)
+	{
+	}
+
+	// Hard cases for rounding: boundaries, subnormals, halfway points and long mantissas
+	for (auto text : {
+		"0.1", "0.3", "1e23", "8.98846567431158e307", "1.7976931348623157e308", "1.7976931348623158e308", "1e309",
+		"2.2250738585072011e-308", "2.2250738585072012e-308", "4.9406564584124654e-324", "2.4703282292062327e-324",
+		"2.4703282292062328e-324", "1e-400", "7.038531e-26", "9007199254740993.0", "9007199254740992.9999999999999999999",
+		"3.14159265358979323846264338327950288", "0.30000000000000004441", "123456789012345678901234567890e-10",
+		"4.4501477170144022721148195934182639518696390927032912960468522194496444440421538910330590478162701758282983178260792422137401728773891892910553144148156412434867599762821265346585071045737627442980259622449029037796981144446145705102663115100318287949527959668236039986479250965780342141637013812613333119898765515451440315261253813266652951306000184917766328660755595837392240989947807556594098101021612198814605258742579179000071675999344145086087205681577915435923018910334964869420614052182892431445797605163650903606514140377217442262561590244668525767372446430075513332450079650686719491377688478005309963967709758965844137894433796621993967316936280457084866613206797017728916080020698679408551343728867675409720757232455434770912461317493580281734466552734375e-308",
+		"0.000000000000000000000000000000000000000000000000000000000000001", "1000000000000000000000000000000000000000000000" })
+	{
+		if (!TestReadingDoubleMatchesStrtod(text))
+			success = false;
+	}
+
+	// Random doubles at different printed precisions, each of which should round trip to the same value strtod gives
+	std::mt19937_64 random(46);
+	for (auto i = 0; i < 20000; i++)
+	{
+		std::uint64_t bits;
+		double value;
+		do
+		{
+			bits = random();
+			std::memcpy(&value, &bits, sizeof(value));
+		} while (value != value || value - value != 0.0); // No NaN or infinity
+		for (auto format : { "%.17g", "%.16g", "%.15g", "%.6g", "%.25e" })
+		{
+			char text[64];
+			std::snprintf(text, sizeof(text), format, value);
+			if (!TestReadingDoubleMatchesStrtod(text))
+				success = false;
+		}
+	}
+	return success;
+}
+
+// Strings of every length up to a few vectors, with escapes at every offset, so that wide scanning is exercised
+// across alignment boundaries and its scalar head and tail
+static bool TestReadingLongStrings()
+{
+	auto success = true;
+	for (std::size_t length = 0; length < 100; length++)
+	{
+		for (std::size_t escapeAt = 0; escapeAt <= length; escapeAt++)
+		{
+			Stringified text(length, u8'a');
+			Stringified expected = text;
+			text.insert(escapeAt, u8"\\n"sv);
+			expected.insert(escapeAt, u8"\n"sv);
+			if (TestParseValue(u8"\"" + text + u8"\"").As<StringView>() != expected)
+				success = false;
+		}
+
+		// Unescaped control characters are rejected wherever they appear
+		Stringified text(length, u8'a');
+		text.push_back(u8'\t');
+		try
+		{
+			TestParseValue(u8"\"" + text + u8"\"");
+			success = false;
+		}
+		catch (const ParseException&)
+		{
+		}
+	}
+	return success;
+}
+
 template<class ValueType_>
 static Stringified TestStringifyValue(ValueType_ value)
 {
@@ -279,8 +2033,29 @@ int main(int argc, char* argv[])
 			exitCode = -1;
 
 		if (!TestReadingBasicTypes() ||
+			!TestReadingLongStrings() ||
+			!TestReadingNumbers() ||
 			!TestReadingWithJsonCheckerFiles(argv[0]) ||
-			!TestReadingWithNativeJsonFiles(argv[0]))
+			!TestReadingWithNativeJsonFiles(argv[0]) ||
+			!TestReadingWithStack(argv[0]) ||
+			!TestReadingWithProjection(argv[0]) ||
+			!TestReadingWithBinding(argv[0]) ||
+			!TestReadingInParallel(argv[0]) ||
+			!TestReadingWithLength(argv[0]) ||
+			!TestReadingReadOnly(argv[0]) ||
+			!TestReadingFromFile(argv[0]) ||
+			!TestReadingWithEvents(argv[0]) ||
+			!TestReadingWithChunks(argv[0]) ||
+			!TestReadingLines() ||
+			!TestReadingWithLazyNumbers(argv[0]) ||
+			!TestReadingWithPackedNumbers(argv[0]) ||
+			!TestReadingWithTape(argv[0]) ||
+			!TestReadingWithCursor(argv[0]) ||
+			!TestReadingWithPointer() ||
+			!TestReadingWithKeySet() ||
+			!TestReadingWithMemoryResource(argv[0]) ||
+			!TestReparse(argv[0]) ||
+			!BenchmarkMinifiedAndPrettyPrinted(argv[0]))
 			exitCode = -1;
 	}
 	catch (const exception& error)
@@ -1,8 +1,13 @@
 #pragma once
-#include <map>
 #include <vector>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <cstdint>
+#include <memory_resource>
 #include <string_view>
 #include "StringType.hpp"
+#include "ParseSimd.hpp"
 
 namespace August
 {
@@ -11,8 +16,165 @@ namespace August
 
 	using ParseIterator = Character*;
 	class ParseToken;
-	using ObjectsTable = std::vector<std::map<StringView, ParseToken>>;
-	using ArraysTable = std::vector<std::vector<ParseToken>>;
+	template<class Token_> class ObjectMembers;
+	using ObjectsTable = std::pmr::vector<ObjectMembers<ParseToken>>;
+	using ArraysTable = std::pmr::vector<std::pmr::vector<ParseToken>>;
+
+	// Bytes of writable slack required beyond the end of a document given by length rather than zero termination.
+	// The first of them is overwritten with a zero terminator, the rest allow for reading whole vectors past the end.
+	constexpr std::size_t ParsePadding = 64;
+
+	// Choices of parsing behaviour which can be combined
+	enum class ParseOptions : unsigned
+	{
+		None = 0,
+		LazyNumbers = 1 << 0, // Keep the text of numbers, only converting them when read
+		PackedNumbers = 1 << 1 // Pack arrays of numbers all of one type, rather than keeping a token per element
+	};
+	constexpr ParseOptions operator|(ParseOptions lhs, ParseOptions rhs) noexcept
+	{
+		return static_cast<ParseOptions>(static_cast<unsigned>(lhs) | static_cast<unsigned>(rhs));
+	}
+	constexpr bool operator&(ParseOptions lhs, ParseOptions rhs) noexcept
+	{
+		return (static_cast<unsigned>(lhs) & static_cast<unsigned>(rhs)) != 0;
+	}
+
+	// Chooses the parse of a buffer that mustn't be written to, as in ParseDocument(ReadOnly, text).
+	// It's slower for strings with escapes, so it's asked for by name rather than chosen by the constness of a pointer.
+	struct ReadOnlyBuffer
+	{
+		explicit constexpr ReadOnlyBuffer() noexcept = default;
+	};
+	inline constexpr ReadOnlyBuffer ReadOnly{};
+
+	// A string containing escape sequences in a document parsed from a read only buffer.
+	// It's only decoded, into storage kept alongside the document, when first read.
+	struct EscapedString
+	{
+		const Character* Text; // Between the quotes, still escaped
+		std::size_t Length;
+		std::pmr::memory_resource* Storage; // For the decoded text
+		mutable const Character* DecodedText = nullptr; // Set on first read, so concurrent first reads need external synchronisation
+		mutable std::size_t DecodedLength = 0;
+	};
+
+	// The side storage for the strings of a document parsed from a read only buffer
+	struct EscapedStrings
+	{
+		std::pmr::deque<EscapedString> Strings; // A deque, as tokens refer to these by address
+		std::pmr::monotonic_buffer_resource Decoded;
+		// Those kept by position, for cursors that read the same text again each time they walk past it
+		std::pmr::unordered_map<const Character*, EscapedString*> Kept;
+
+		explicit EscapedStrings(std::pmr::memory_resource* resource) :
+			Strings(resource),
+			Decoded(resource),
+			Kept(resource)
+		{
+		}
+
+		// The string with this text, made the first time it's asked for, so storage grows only with different strings read
+		const EscapedString& Keep(const Character* text, std::size_t length)
+		{
+			auto& kept = Kept[text];
+			if (!kept)
+				kept = &Strings.emplace_back(EscapedString{ text, length, &Decoded });
+			return *kept;
+		}
+	};
+
+	// A view of an array of numbers packed by ParseOptions::PackedNumbers, as std::span<const Value_> would be
+	template<class Value_>
+	class PackedNumbers
+	{
+		const Value_* _data;
+		std::size_t _size;
+	public:
+		constexpr PackedNumbers(const Value_* data, std::size_t size) noexcept :
+			_data(data),
+			_size(size)
+		{
+		}
+
+		constexpr const Value_* data() const noexcept
+		{
+			return _data;
+		}
+		constexpr std::size_t size() const noexcept
+		{
+			return _size;
+		}
+		constexpr bool empty() const noexcept
+		{
+			return !_size;
+		}
+		constexpr const Value_* begin() const noexcept
+		{
+			return _data;
+		}
+		constexpr const Value_* end() const noexcept
+		{
+			return _data + _size;
+		}
+		constexpr const Value_& operator[](std::size_t index) const noexcept
+		{
+			return _data[index];
+		}
+	};
+
+	// The arrays of numbers of a document parsed with ParseOptions::PackedNumbers, each a run of a pool for its type.
+	// A pair of doubles takes 24 bytes here, with its run, where as tokens with their entry in the arrays table it would take 64.
+	struct NumbersTable
+	{
+		// Kept small, as there's one for every packed array, so pools are limited to 2^32 numbers
+		struct Run
+		{
+			std::uint32_t Offset;
+			std::uint32_t Count;
+		};
+
+		std::pmr::vector<double> FloatingPoints;
+		std::pmr::vector<std::int64_t> Integers;
+		std::pmr::vector<Run> Arrays;
+		// Tokens for the elements of those read as a ParseArray, made on first read, keyed by array and referred to by address.
+		// Only arrays read have an entry. It's made under the lock and allocated with new and delete rather than from the
+		// document's memory resource, which needn't be thread safe, so reads from several threads are safe.
+		mutable std::mutex Lock;
+		mutable std::pmr::unordered_map<std::size_t, std::pmr::vector<ParseToken>> Elements;
+
+		explicit NumbersTable(std::pmr::memory_resource* resource) :
+			FloatingPoints(resource),
+			Integers(resource),
+			Arrays(resource),
+			Elements(std::pmr::new_delete_resource())
+		{
+		}
+
+		// Keeping capacity for the next document
+		void clear() noexcept
+		{
+			FloatingPoints.clear();
+			Integers.clear();
+			Arrays.clear();
+			Elements.clear();
+		}
+	};
+
+	// Everything shared by the parsing functions whilst building a document, passed as one to keep recursion cheap
+	struct ParseContext
+	{
+		ObjectsTable& Objects;
+		ArraysTable& Arrays;
+		ParseOptions Options;
+		// How much of each table this parse has used. Tables can be larger, left over from a previous parse for reuse.
+		std::size_t ObjectsUsed = 0;
+		std::size_t ArraysUsed = 0;
+		// Only when parsing a read only buffer, which means strings mustn't be unescaped in place
+		EscapedStrings* Escapes = nullptr;
+		// Only when parsing with ParseOptions::PackedNumbers
+		NumbersTable* Numbers = nullptr;
+	};
 
 	static constexpr bool IsWhitespace(Character byte) noexcept
 	{
@@ -21,28 +183,32 @@ namespace August
 		return byte == 0x9 || byte == 0xA || byte == 0xD || byte == 0x20;
 	}
 
-	static constexpr Character SkipWhitespace(ParseIterator& start) noexcept
+	static inline Character SkipWhitespace(ParseIterator& start) noexcept
 	{
+		// Most gaps between tokens are empty or a single space, which are cheapest checked a byte at a time.
+		// Anything longer is likely indentation, where checking a whole vector at a time pays off.
 		auto iterator = start;
-		for (;;)
-		{
-			auto character = *iterator;
-			if (!character)
-			{
-				start = iterator;
-				return 0; // Return 0 to signal EOF whilst skipping whitespace
-			}
-			if (!IsWhitespace(character))
-			{
-				start = iterator;
-				return character;
-			}
-			iterator++;
+		auto character = *iterator;
+		if (!IsWhitespace(character))
+			return character; // Also returns 0 to signal EOF whilst skipping whitespace
+		character = *++iterator;
+		if (IsWhitespace(character))
+		{
+			iterator = ParseSimd::FindNonWhitespace(iterator + 1);
+			character = *iterator;
 		}
+		start = iterator;
+		return character;
 	}
 
 	// The main interpretation method given an initial non-whitespace character.
 	// To avoid recursive includes, any parsing code can include this header and use this function but the definition is elsewhere
-	extern ParseToken ParseAny(ObjectsTable& objects, ArraysTable& arrays, Character character, ParseIterator& iterator);
+	extern ParseToken ParseAny(ParseContext& context, Character character, ParseIterator& iterator);
+
+	// Conversion of number text kept by ParseOptions::LazyNumbers, defined alongside ParseNumber for the same reason
+	extern ParseToken ParseNumberText(const Character* text);
+
+	// Decoding of a string from a read only buffer when it's first read, defined alongside ParseString for the same reason
+	extern StringView ParseEscapedText(const EscapedString& escaped);
 
 }
@@ -1,16 +1,19 @@
 #pragma once
 #include <cassert>
+#include <cstdint>
+#include <limits>
 #include "Parse.hpp"
 #include "ParseToken.hpp"
+#include "ParseNumber.hpp"
 #include "ParseException.hpp"
 
 namespace August
 {
 
 	// Providing parsing of an array
-	// The rest of the time for querying, all functionality is in the base class std::vector<ParseToken>
+	// The rest of the time for querying, all functionality is in the base class std::pmr::vector<ParseToken>
 
-	class ParseArray : public std::vector<ParseToken>
+	class ParseArray : public std::pmr::vector<ParseToken>
 	{
 		// We never instance, copy or move
 		void operator=(const ParseArray&) = delete;
@@ -28,16 +31,99 @@ namespace August
 		static constexpr Character ClosingBracket = ']';
 		static constexpr Character CommaSeparator = ',';
 
+		// Storage for a new array, reusing any left in the table by a previous parse to keep its capacity
+		static std::size_t NewArray(ParseContext& context)
+		{
+			auto& arrays = context.Arrays;
+			auto arrayIndex = context.ArraysUsed++;
+			if (arrayIndex == arrays.size())
+				arrays.emplace_back().reserve(DefaultSize);
+			else
+				arrays[arrayIndex].clear();
+			return arrayIndex;
+		}
+
+		// With ParseOptions::PackedNumbers, an array whose elements are all integers, or all floating point numbers, is packed
+		// into the pool for its type with no token per element. Any other array is left to be parsed again as usual,
+		// keeping the type of each element, so the iterator is only moved on success.
+		static bool ParsePacked(ParseContext& context, Character character, ParseIterator& iterator, ParseToken& token)
+		{
+			auto& numbers = *context.Numbers;
+			auto floatingPointsUsed = numbers.FloatingPoints.size();
+			auto integersUsed = numbers.Integers.size();
+			auto at = iterator;
+			auto first = ParseNumber::Parse(character, at);
+			auto integers = first.IsInteger();
+			if (integers)
+				numbers.Integers.push_back(first.As<std::int64_t>());
+			else if (first.IsFloatingPoint())
+				numbers.FloatingPoints.push_back(first.As<double>());
+			else
+				return false;
+
+			for (;;)
+			{
+				character = SkipWhitespace(at);
+				if (character == ClosingBracket)
+					break;
+				auto packed = false;
+				if (character == CommaSeparator)
+				{
+					character = SkipWhitespace(++at);
+					if (character == '-' || (character >= '0' && character <= '9'))
+					{
+						auto element = ParseNumber::Parse(character, at);
+						if (integers && element.IsInteger())
+						{
+							numbers.Integers.push_back(element.As<std::int64_t>());
+							packed = true;
+						}
+						else if (!integers && element.IsFloatingPoint())
+						{
+							numbers.FloatingPoints.push_back(element.As<double>());
+							packed = true;
+						}
+					}
+				}
+				if (!packed)
+				{
+					numbers.Integers.resize(integersUsed);
+					numbers.FloatingPoints.resize(floatingPointsUsed);
+					return false;
+				}
+			}
+
+			auto offset = integers ? integersUsed : floatingPointsUsed;
+			auto end = integers ? numbers.Integers.size() : numbers.FloatingPoints.size();
+			if (end > std::numeric_limits<std::uint32_t>::max())
+			{
+				numbers.Integers.resize(integersUsed);
+				numbers.FloatingPoints.resize(floatingPointsUsed);
+				return false;
+			}
+			iterator = at + 1;
+			numbers.Arrays.push_back(NumbersTable::Run{ static_cast<std::uint32_t>(offset), static_cast<std::uint32_t>(end - offset) });
+			token = ParseToken(integers ? ParseToken::Packed::Integers : ParseToken::Packed::FloatingPoints, &numbers, numbers.Arrays.size() - 1);
+			return true;
+		}
+
 		// The first character matches '[', so interpret the rest as an array
-		static ParseToken Parse(ObjectsTable& objects, ArraysTable& arrays, ParseIterator& start)
+		static ParseToken Parse(ParseContext& context, ParseIterator& start)
 		{
 			auto iterator = start;
 			assert(*iterator == OpeningBracket);
 			auto character = SkipWhitespace(++iterator);
 
+			ParseToken packed;
+			if (context.Numbers && (character == '-' || (character >= '0' && character <= '9')) && ParsePacked(context, character, iterator, packed))
+			{
+				start = iterator;
+				return ParseToken(packed);
+			}
+
 			// Always reserve a new array
-			auto arrayIndex = arrays.size();
-			arrays.emplace_back().reserve(DefaultSize);
+			auto& arrays = context.Arrays;
+			auto arrayIndex = NewArray(context);
 
 			if (character == ClosingBracket)
 				iterator++; // Empty array
@@ -45,7 +131,7 @@ namespace August
 			{
 				for (;;)
 				{
-					auto token = ParseAny(objects, arrays, character, iterator);
+					auto token = ParseAny(context, character, iterator);
 
 					// Note that we don't keep a reference to &arrays[arrayIndex] for the duration
 					// because ParseAny() may introduce more arrays and resize and possibly move
@@ -0,0 +1,268 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+#include <tuple>
+#include <bitset>
+#include <optional>
+#include <utility> // std::index_sequence
+#include <type_traits>
+#include "Parse.hpp"
+#include "ParseToken.hpp"
+#include "ParseObject.hpp"
+#include "ParseArray.hpp"
+#include "ParseString.hpp"
+#include "ParseBoolean.hpp"
+#include "ParseNull.hpp"
+#include "ParseNumber.hpp"
+#include "ParseGrammar.hpp"
+#include "ParseProjection.hpp"
+#include "ParseKeySet.hpp"
+#include "ParseException.hpp"
+
+namespace August
+{
+
+	// Parsing straight into the caller's own types, without building any tables.
+	// A struct is bound by specialising ParseBinding with a constexpr tuple of its fields, each naming the member it's read from:
+	//     template<> struct August::ParseBinding<Point>
+	//     {
+	//         static constexpr auto Fields = std::make_tuple(August::BindField(u8"x"sv, &Point::X), August::BindField(u8"y"sv, &Point::Y));
+	//     };
+	// Fields can be bool, integer and floating point types, StringView (referring into the buffer, unescaped in place),
+	// Stringified, std::vector<> and std::optional<> of any of these, and other bound structs. Every member of a bound object
+	// must be present other than std::optional<> ones, which may also be null. Members not bound are stepped over, only
+	// checked as far as their strings and nesting, and of duplicate members the first is taken. A missing member, a value of
+	// the wrong type, or an integer beyond the range of its field throws a ParseException.
+	// Member names are matched with a ParseKeySet of the field names, worked out at compile time.
+
+	template<class Value_>
+	struct ParseBinding
+	{
+	};
+
+	template<class Struct_, class Member_>
+	struct ParseField
+	{
+		StringView Name;
+		Member_ Struct_::* Member;
+	};
+
+	template<class Struct_, class Member_>
+	constexpr ParseField<Struct_, Member_> BindField(StringView name, Member_ Struct_::* member) noexcept
+	{
+		return ParseField<Struct_, Member_>{ name, member };
+	}
+
+	class ParseBinder
+	{
+		template<class Value_, class = void>
+		struct IsBound : std::false_type
+		{
+		};
+
+		template<class Value_>
+		struct IsBound<Value_, decltype(void(ParseBinding<Value_>::Fields))> : std::true_type
+		{
+		};
+
+		template<class Value_>
+		struct IsOptional : std::false_type
+		{
+		};
+
+		template<class Value_>
+		struct IsOptional<std::optional<Value_>> : std::true_type
+		{
+		};
+
+		template<class Value_>
+		using FieldsOf = typename std::decay<decltype(ParseBinding<Value_>::Fields)>::type;
+
+		static ParseToken ReadNumber(Character character, ParseIterator& iterator)
+		{
+			if (character != '-' && (character < '0' || character > '9'))
+				throw ParseException(iterator, "Expecting a number");
+			return ParseNumber::Parse(character, iterator);
+		}
+
+		template<class Value_, std::size_t... Indexes_>
+		static constexpr auto MakeKeys(std::index_sequence<Indexes_...>)
+		{
+			return ParseKeySet<sizeof...(Indexes_)>(std::get<Indexes_>(ParseBinding<Value_>::Fields).Name...);
+		}
+
+		// The names of a struct's fields, so a member name is matched with one hashed lookup
+		template<class Value_>
+		static constexpr auto KeysOf = MakeKeys<Value_>(std::make_index_sequence<std::tuple_size<FieldsOf<Value_>>::value>());
+
+		template<std::size_t Index_, class Value_, std::size_t Count_>
+		static bool ReadField(std::size_t position, Character character, ParseIterator& iterator, Value_& value, std::bitset<Count_>& found)
+		{
+			if (position != Index_)
+				return false;
+			auto& field = std::get<Index_>(ParseBinding<Value_>::Fields);
+			if (found[Index_])
+				iterator = ParseProjection::Skip(iterator);
+			else
+			{
+				Read(character, iterator, value.*field.Member);
+				found[Index_] = true;
+			}
+			return true;
+		}
+
+		// The field of a member with the given name, if any, returning false where there's no such field
+		template<class Value_, std::size_t Count_, std::size_t... Indexes_>
+		static bool ReadFields(StringView name, Character character, ParseIterator& iterator, Value_& value, std::bitset<Count_>& found, std::index_sequence<Indexes_...>)
+		{
+			auto position = KeysOf<Value_>.Find(name);
+			return (ReadField<Indexes_>(position, character, iterator, value, found) || ...);
+		}
+
+		// Optional fields not found are left empty, and any other is an error
+		template<std::size_t Index_, class Value_, std::size_t Count_>
+		static void CheckField(ParseIterator where, Value_& value, const std::bitset<Count_>& found)
+		{
+			auto& field = std::get<Index_>(ParseBinding<Value_>::Fields);
+			if (found[Index_])
+				return;
+			auto& member = value.*field.Member;
+			if constexpr (IsOptional<typename std::decay<decltype(member)>::type>::value)
+				member.reset();
+			else
+			{
+				std::string message = "Missing object member \"";
+				message.append(reinterpret_cast<const char*>(field.Name.data()), field.Name.size());
+				message += '"';
+				throw ParseException(where, message.c_str());
+			}
+		}
+
+		template<class Value_, std::size_t Count_, std::size_t... Indexes_>
+		static void CheckFields(ParseIterator where, Value_& value, const std::bitset<Count_>& found, std::index_sequence<Indexes_...>)
+		{
+			(CheckField<Indexes_>(where, value, found), ...);
+		}
+
+	public:
+		static void Read(Character character, ParseIterator& iterator, bool& value)
+		{
+			if (character == ParseBoolean::FirstTrueCharacter)
+				value = ParseBoolean::ParseTrue(iterator).As<bool>();
+			else if (character == ParseBoolean::FirstFalseCharacter)
+				value = ParseBoolean::ParseFalse(iterator).As<bool>();
+			else
+				throw ParseException(iterator, "Expecting true or false");
+		}
+
+		template<class Value_>
+		static typename std::enable_if<std::numeric_limits<Value_>::is_integer && !std::is_same<Value_, bool>::value>::type
+			Read(Character character, ParseIterator& iterator, Value_& value)
+		{
+			auto where = iterator;
+			auto token = ReadNumber(character, iterator);
+			if (!token.IsInteger() && !token.IsUnsignedInteger())
+				throw ParseException(where, "Expecting an integer");
+			if (token.IsUnsignedInteger())
+			{
+				if (token.As<std::uint64_t>() > static_cast<std::uint64_t>(std::numeric_limits<Value_>::max()))
+					throw ParseException(where, "Integer out of range");
+				value = static_cast<Value_>(token.As<std::uint64_t>());
+				return;
+			}
+			auto integer = token.As<std::int64_t>();
+			if (integer < static_cast<std::int64_t>(std::numeric_limits<Value_>::lowest()) ||
+				(integer > 0 && static_cast<std::uint64_t>(integer) > static_cast<std::uint64_t>(std::numeric_limits<Value_>::max())))
+				throw ParseException(where, "Integer out of range");
+			value = static_cast<Value_>(integer);
+		}
+
+		template<class Value_>
+		static typename std::enable_if<std::is_floating_point<Value_>::value>::type
+			Read(Character character, ParseIterator& iterator, Value_& value)
+		{
+			value = ReadNumber(character, iterator).As<Value_>();
+		}
+
+		static void Read(Character character, ParseIterator& iterator, StringView& value)
+		{
+			if (character != ParseString::Quotes)
+				throw ParseException(iterator, "Expecting a string");
+			value = ParseString::ParseToView(iterator);
+		}
+
+		static void Read(Character character, ParseIterator& iterator, Stringified& value)
+		{
+			if (character != ParseString::Quotes)
+				throw ParseException(iterator, "Expecting a string");
+			value = ParseString::ParseToView(iterator);
+		}
+
+		// Elements are read over those already in the vector, so its capacity is kept between documents
+		template<class Value_>
+		static void Read(Character character, ParseIterator& iterator, std::vector<Value_>& value)
+		{
+			if (character != ParseArray::OpeningBracket)
+				throw ParseException(iterator, "Expecting an array");
+			value.clear();
+			ParseGrammar::Array(iterator, [&value](Character next, ParseIterator& at)
+			{
+				// The elements of std::vector<bool> are packed as bits, so are read through a local
+				if constexpr (std::is_same<Value_, bool>::value)
+				{
+					bool element;
+					Read(next, at, element);
+					value.push_back(element);
+				}
+				else
+					Read(next, at, value.emplace_back());
+			});
+		}
+
+		template<class Value_>
+		static void Read(Character character, ParseIterator& iterator, std::optional<Value_>& value)
+		{
+			if (character == ParseNull::FirstCharacter)
+			{
+				ParseNull::Parse(iterator);
+				value.reset();
+				return;
+			}
+			if (!value)
+				value.emplace();
+			Read(character, iterator, *value);
+		}
+
+		// Each member is read into its field, or stepped over when there's no field for it
+		template<class Value_>
+		static typename std::enable_if<IsBound<Value_>::value>::type
+			Read(Character character, ParseIterator& iterator, Value_& value)
+		{
+			constexpr auto count = std::tuple_size<FieldsOf<Value_>>::value;
+			using Indexes = std::make_index_sequence<count>;
+			if (character != ParseObject::OpeningBraces)
+				throw ParseException(iterator, "Expecting an object");
+			std::bitset<count> found;
+			ParseGrammar::Object(iterator, ParseGrammar::InPlaceNames(), [&](StringView name, Character next, ParseIterator& at)
+			{
+				if (!ReadFields(name, next, at, value, found, Indexes()))
+					at = ParseProjection::Skip(at);
+			});
+			CheckFields(iterator - 1, value, found, Indexes());
+		}
+	};
+
+	// Read the whole document into the value, which may be a bound struct or anything a field can be.
+	// The buffer has the same requirements as for ParseDocument, and needs to outlive any StringView read from it.
+	template<class Value_>
+	void ParseInto(ParseIterator iterator, Value_& value)
+	{
+		ParseGrammar::Document(iterator, [&value](Character next, ParseIterator& at)
+		{
+			ParseBinder::Read(next, at, value);
+		});
+	}
+
+}
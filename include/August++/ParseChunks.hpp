@@ -0,0 +1,327 @@
+#pragma once
+#include <vector>
+#include "Parse.hpp"
+#include "ParseToken.hpp"
+#include "ParseObject.hpp"
+#include "ParseArray.hpp"
+#include "ParseString.hpp"
+#include "ParseBoolean.hpp"
+#include "ParseNull.hpp"
+#include "ParseNumber.hpp"
+#include "ParseGrammar.hpp"
+#include "ParseException.hpp"
+
+namespace August
+{
+
+	// Parsing of a document that arrives in pieces, such as from a socket, giving the same events as ParseEvents.
+	// Each chunk is interpreted as it's fed, so only an unfinished string, number or literal is ever kept back
+	// until the rest of it arrives. Chunks can split the document anywhere, including within escape sequences.
+	// Strings and number text passed to the handler only last for the duration of the call.
+	// Errors throw a ParseException whose location is within the parser's own copy of a token or the chunk being fed,
+	// so use Position() for where it is in the whole document. Once thrown, the parser can't be used further.
+
+	template<class Handler_>
+	class ParseChunks
+	{
+		// We never copy or move
+		void operator=(const ParseChunks&) = delete;
+		void operator=(const ParseChunks&&) = delete;
+		ParseChunks(const ParseChunks&) = delete;
+		ParseChunks(const ParseChunks&&) = delete;
+
+		// What's expected next in the document
+		enum class State
+		{
+			Value,
+			FirstElement, // A value or the end of an empty array
+			FirstMember, // A member name or the end of an empty object
+			Member,
+			NameSeparator,
+			Next, // The end of the enclosing container or a comma, or only whitespace once the document is complete
+			String, // Part way through a string, number or literal
+			Number,
+			Literal
+		};
+
+		Handler_& _handler;
+		ParseOptions _options;
+		State _state = State::Value;
+		std::vector<bool> _containers; // Whether each open container is an object rather than an array
+		std::vector<Character> _token; // The token gathered so far
+		std::size_t _tokenPosition = 0;
+		bool _key = false; // Whether the string being gathered is a member name
+		bool _escaped = false; // Whether the last character of the string gathered was an unescaped backslash
+		std::size_t _position = 0;
+
+		static constexpr bool IsNumberCharacter(Character character) noexcept
+		{
+			return (character >= '0' && character <= '9') || character == '-' || character == '+' || character == '.' || character == 'e' || character == 'E';
+		}
+
+		static constexpr bool IsLiteralCharacter(Character character) noexcept
+		{
+			return character >= 'a' && character <= 'z';
+		}
+
+		[[noreturn]] static void Fail(const Character* where, const char* message)
+		{
+			throw ParseException(where, message);
+		}
+
+		void StartToken(State state, Character character)
+		{
+			_state = state;
+			_token.clear();
+			_token.push_back(character);
+			_tokenPosition = _position;
+			_escaped = false;
+		}
+
+		void EndValue()
+		{
+			_state = State::Next;
+		}
+
+		void Close()
+		{
+			if (_containers.back())
+				_handler.EndObject();
+			else
+				_handler.EndArray();
+			_containers.pop_back();
+			EndValue();
+		}
+
+		// Interpret the token gathered, with the same scanners as the other parses work on the whole document
+		void CompleteToken()
+		{
+			_token.push_back(0);
+			auto iterator = _token.data();
+			try
+			{
+				switch (_state)
+				{
+				case State::String:
+				{
+					auto name = ParseString::ParseToView(iterator);
+					if (_key)
+					{
+						_handler.Key(name);
+						_state = State::NameSeparator;
+					}
+					else
+					{
+						_handler.Value(ParseToken(name.data(), name.size()));
+						EndValue();
+					}
+					return;
+				}
+
+				case State::Literal:
+					if (*iterator == ParseNull::FirstCharacter)
+						_handler.Value(ParseNull::Parse(iterator));
+					else if (*iterator == ParseBoolean::FirstTrueCharacter)
+						_handler.Value(ParseBoolean::ParseTrue(iterator));
+					else
+						_handler.Value(ParseBoolean::ParseFalse(iterator));
+					break;
+
+				default:
+					if (_options & ParseOptions::LazyNumbers)
+						_handler.Value(ParseNumber::ParseText(*iterator, iterator));
+					else
+						_handler.Value(ParseNumber::Parse(*iterator, iterator));
+					break;
+				}
+			}
+			catch (const ParseException& error)
+			{
+				_position = _tokenPosition + static_cast<std::size_t>(error.Where - _token.data());
+				throw;
+			}
+			EndValue();
+
+			// Anything gathered beyond the end of a number or literal follows it in the document
+			auto position = _position;
+			for (auto end = _token.data() + _token.size() - 1; iterator != end; iterator++)
+			{
+				_position = _tokenPosition + static_cast<std::size_t>(iterator - _token.data());
+				Process(*iterator, iterator);
+			}
+			_position = position;
+		}
+
+		// Interpret one character, at the given location for the sake of errors.
+		// Only the zero Finish() passes ends the document, and any other in a chunk is content like the rest.
+		void Process(Character character, const Character* where, bool finishing = false)
+		{
+			switch (_state)
+			{
+			case State::String:
+				_token.push_back(character);
+				if (_escaped)
+					_escaped = false;
+				else if (character == '\\')
+					_escaped = true;
+				else if (character == ParseString::Quotes)
+					CompleteToken();
+				return;
+
+			case State::Number:
+				if (IsNumberCharacter(character))
+				{
+					_token.push_back(character);
+					return;
+				}
+				CompleteToken();
+				break;
+
+			case State::Literal:
+				if (IsLiteralCharacter(character))
+				{
+					_token.push_back(character);
+					return;
+				}
+				CompleteToken();
+				break;
+
+			default:
+				break;
+			}
+
+			if (IsWhitespace(character))
+				return;
+			switch (_state)
+			{
+			case State::FirstElement:
+				if (character == ParseArray::ClosingBracket)
+				{
+					Close();
+					return;
+				}
+				[[fallthrough]];
+			case State::Value:
+				switch (character)
+				{
+				case ParseObject::OpeningBraces:
+					_handler.StartObject();
+					_containers.push_back(true);
+					_state = State::FirstMember;
+					return;
+
+				case ParseArray::OpeningBracket:
+					_handler.StartArray();
+					_containers.push_back(false);
+					_state = State::FirstElement;
+					return;
+
+				case ParseString::Quotes:
+					_key = false;
+					StartToken(State::String, character);
+					return;
+
+				case ParseNull::FirstCharacter:
+				case ParseBoolean::FirstTrueCharacter:
+				case ParseBoolean::FirstFalseCharacter:
+					StartToken(State::Literal, character);
+					return;
+
+				default:
+					// Anything else is a number or an unrecognised token, which the number scanner reports
+					StartToken(State::Number, character);
+					if (!IsNumberCharacter(character))
+						CompleteToken();
+					return;
+				}
+
+			case State::FirstMember:
+				if (character == ParseObject::ClosingBraces)
+				{
+					Close();
+					return;
+				}
+				[[fallthrough]];
+			case State::Member:
+				ParseGrammar::CheckMemberName(character, where);
+				_key = true;
+				StartToken(State::String, character);
+				return;
+
+			case State::NameSeparator:
+				ParseGrammar::CheckNameSeparator(character, where);
+				_state = State::Value;
+				return;
+
+			default: // State::Next
+				if (_containers.empty())
+				{
+					if (!finishing)
+						Fail(where, "Unexpected content after main document");
+				}
+				else if (_containers.back())
+				{
+					if (ParseGrammar::MoreMembers(character, where))
+						_state = State::Member;
+					else
+						Close();
+				}
+				else if (ParseGrammar::MoreElements(character, where))
+					_state = State::Value;
+				else
+					Close();
+				return;
+			}
+		}
+
+	public:
+		explicit ParseChunks(Handler_& handler, ParseOptions options = ParseOptions::None) :
+			_handler(handler),
+			_options(options)
+		{
+		}
+
+		// The next piece of the document, which needn't be zero terminated and isn't referred to once this returns
+		void Feed(const Character* data, std::size_t length)
+		{
+			auto end = data + length;
+			while (data != end)
+			{
+				if (_state == State::String && !_escaped)
+				{
+					// Gather the plain run of a string at once
+					auto special = data;
+					while (special != end && *special != ParseString::Quotes && *special != '\\')
+						special++;
+					_token.insert(_token.end(), data, special);
+					_position += static_cast<std::size_t>(special - data);
+					data = special;
+					if (data == end)
+						break;
+				}
+				Process(*data, data);
+				data++;
+				_position++;
+			}
+		}
+
+		// There's no more to the document, which is checked for being complete
+		void Finish()
+		{
+			const Character terminator = 0;
+			if (_state == State::String)
+				CompleteToken(); // Which reports the missing end of the string
+			else
+				Process(terminator, &terminator, true);
+			if (_state != State::Next || !_containers.empty())
+				Fail(&terminator, "Incomplete document");
+		}
+
+		// How far through the whole document parsing has reached, or where the error is after a ParseException
+		std::size_t Position() const noexcept
+		{
+			return _position;
+		}
+	};
+
+}
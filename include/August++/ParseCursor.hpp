@@ -0,0 +1,491 @@
+#pragma once
+#include <utility> // std::pair<>
+#include <iterator>
+#include <stdexcept> // std::out_of_range
+#include <type_traits>
+#include <typeinfo> // bad_cast
+#include <memory_resource>
+#include "Parse.hpp"
+#include "ParseToken.hpp"
+#include "ParseObject.hpp"
+#include "ParseArray.hpp"
+#include "ParseString.hpp"
+#include "ParseGrammar.hpp"
+#include "ParseBoolean.hpp"
+#include "ParseNull.hpp"
+#include "ParseNumber.hpp"
+#include "ParseException.hpp"
+
+namespace August
+{
+
+	// On demand reading, straight from the buffer without building any tables.
+	// A cursor is just the position of a value. Objects and arrays are walked each time they're searched or iterated,
+	// stepping over the values that aren't wanted by matching brackets, so reading a few members of a large document
+	// costs little more than finding them. Numbers, booleans and strings are interpreted by the regular scanners
+	// only when read, with the same validation and errors as the regular parse. Values stepped over are only checked
+	// as far as their strings and nesting, and anything after the root value isn't looked at.
+	// The buffer is never written to, so may be read only, but must be zero terminated and outlive the cursors.
+
+	class ObjectCursor;
+	class ArrayCursor;
+
+	class ValueCursor
+	{
+		friend class ObjectCursor;
+		friend class ArrayCursor;
+		friend class ParseProjection;
+
+		// Where the object or array starting at the given bracket ends, checking only strings and nesting.
+		// From within one, give the depth already entered instead.
+		static const Character* SkipContainer(const Character* at, std::size_t depth = 0)
+		{
+			for (;;)
+			{
+				switch (*at)
+				{
+				case ParseObject::OpeningBraces:
+				case ParseArray::OpeningBracket:
+					depth++;
+					break;
+
+				case ParseObject::ClosingBraces:
+				case ParseArray::ClosingBracket:
+					if (!--depth)
+						return at + 1;
+					break;
+
+				case ParseString::Quotes:
+				{
+					auto iterator = Iterator(at);
+					bool escaped;
+					ParseString::ScanToView(iterator, escaped);
+					at = iterator;
+					continue;
+				}
+
+				case 0:
+					throw ParseException(at, "No end of object or array");
+				}
+				at++;
+			}
+		}
+
+	protected:
+		const Character* _at; // The first character of the value
+		EscapedStrings* _escapes; // Where escaped strings are decoded
+
+		// Nothing is written to the document, so it's safe to drop the const for the scanners' iterators
+		static ParseIterator Iterator(const Character* at) noexcept
+		{
+			return const_cast<ParseIterator>(at);
+		}
+
+		// Where the value starting at the given position ends, checking only its strings and nesting as for a container.
+		// Numbers, booleans and null aren't converted, and run up to the next separator.
+		static const Character* Skip(const Character* at)
+		{
+			switch (*at)
+			{
+			case ParseObject::OpeningBraces:
+			case ParseArray::OpeningBracket:
+				return SkipContainer(at);
+
+			case ParseString::Quotes:
+			{
+				auto iterator = Iterator(at);
+				bool escaped;
+				ParseString::ScanToView(iterator, escaped);
+				return iterator;
+			}
+
+			default:
+			{
+				auto start = at;
+				for (auto character = *at; character && !IsWhitespace(character) && character != ParseObject::Comma &&
+					character != ParseObject::ClosingBraces && character != ParseArray::ClosingBracket; character = *++at);
+				if (at == start)
+					throw ParseException(at, "Expecting a value");
+				return at;
+			}
+			}
+		}
+
+		// A number, boolean, null or string, leaving the iterator following it.
+		// Without anywhere to decode to, strings with escapes are only checked.
+		static ParseToken Read(Character character, ParseIterator& iterator, EscapedStrings* escapes)
+		{
+			switch (character)
+			{
+			case ParseObject::OpeningBraces:
+			case ParseArray::OpeningBracket:
+				throw std::bad_cast();
+
+			case ParseNull::FirstCharacter:
+				return ParseNull::Parse(iterator);
+
+			case ParseString::Quotes:
+			{
+				bool escaped;
+				auto text = ParseString::ScanToView(iterator, escaped);
+				if (!escaped || !escapes)
+					return ParseToken(text.data(), text.size());
+				return ParseToken(&escapes->Keep(text.data(), text.size()));
+			}
+
+			case ParseBoolean::FirstTrueCharacter:
+				return ParseBoolean::ParseTrue(iterator);
+
+			case ParseBoolean::FirstFalseCharacter:
+				return ParseBoolean::ParseFalse(iterator);
+
+			default:
+				return ParseNumber::Parse(character, iterator);
+			}
+		}
+
+	public:
+		constexpr ValueCursor(const Character* at, EscapedStrings* escapes) noexcept :
+			_at(at),
+			_escapes(escapes)
+		{
+		}
+
+		bool IsNull() const noexcept
+		{
+			return *_at == ParseNull::FirstCharacter;
+		}
+
+		bool IsObject() const noexcept
+		{
+			return *_at == ParseObject::OpeningBraces;
+		}
+
+		bool IsArray() const noexcept
+		{
+			return *_at == ParseArray::OpeningBracket;
+		}
+
+		bool IsBoolean() const noexcept
+		{
+			return *_at == ParseBoolean::FirstTrueCharacter || *_at == ParseBoolean::FirstFalseCharacter;
+		}
+
+		bool IsString() const noexcept
+		{
+			return *_at == ParseString::Quotes;
+		}
+
+		bool IsNumber() const noexcept
+		{
+			return *_at == '-' || (*_at >= '0' && *_at <= '9');
+		}
+
+		// The value as a token, interpreted now. Objects and arrays throw std::bad_cast.
+		ParseToken Token() const
+		{
+			auto iterator = Iterator(_at);
+			return Read(*_at, iterator, _escapes);
+		}
+
+		// Numbers, booleans and strings read exactly as they do from a ParseToken
+		template<typename ValueType_>
+		typename std::enable_if<
+			!std::is_same<ValueType_, ObjectCursor>::value &&
+			!std::is_same<ValueType_, ArrayCursor>::value,
+			ValueType_>::type As() const
+		{
+			return Token().As<ValueType_>();
+		}
+
+		// Containers are returned as cursors onto their members or elements
+		template<typename ValueType_>
+		typename std::enable_if<
+			std::is_same<ValueType_, ObjectCursor>::value,
+			ValueType_>::type As() const
+		{
+			if (!IsObject())
+				throw std::bad_cast();
+			return ValueType_(_at, _escapes);
+		}
+
+		template<typename ValueType_>
+		typename std::enable_if<
+			std::is_same<ValueType_, ArrayCursor>::value,
+			ValueType_>::type As() const
+		{
+			if (!IsArray())
+				throw std::bad_cast();
+			return ValueType_(_at, _escapes);
+		}
+
+		// Shorthand for finding members and elements, throwing std::bad_cast when this isn't an object or array
+		ValueCursor operator[](StringView name) const;
+		ValueCursor operator[](std::size_t index) const;
+	};
+
+	// The members of an object in document order, found by walking from the opening brace each time.
+	// Names aren't required to be unique; like ParseObject, lookup finds the first member with a name.
+
+	class ObjectCursor
+	{
+		const Character* _opening;
+		EscapedStrings* _escapes;
+	public:
+		constexpr ObjectCursor(const Character* opening, EscapedStrings* escapes) noexcept :
+			_opening(opening),
+			_escapes(escapes)
+		{
+		}
+
+		class const_iterator
+		{
+			friend class ObjectCursor;
+
+			const Character* _name = nullptr; // The member name's opening quotes, or null once past the end
+			const Character* _value = nullptr;
+			EscapedStrings* _escapes = nullptr;
+			StringView _text; // The member name, still escaped where _escaped
+			bool _escaped = false;
+
+			// Compared without decoding, so searches keep nothing for the names they pass
+			bool Named(StringView name) const
+			{
+				if (!_escaped)
+					return _text == name;
+				return ParseString::DecodesTo(_text.data(), _text.size(), name);
+			}
+
+			// One step of ParseGrammar::Members(), from the character following the opening brace or a value
+			void Next(ParseIterator iterator, bool first)
+			{
+				auto character = SkipWhitespace(iterator);
+				if (first ? character == ParseObject::ClosingBraces : !ParseGrammar::MoreMembers(character, iterator))
+				{
+					_name = nullptr;
+					return;
+				}
+				if (!first)
+					character = SkipWhitespace(++iterator);
+				_name = iterator;
+				ParseGrammar::MemberName(iterator, character, [this](ParseIterator& at)
+				{
+					return ParseString::ScanToView(at, _escaped);
+				}, _text);
+				_value = iterator;
+			}
+
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = std::pair<StringView, ValueCursor>;
+			using difference_type = std::ptrdiff_t;
+			using pointer = void;
+			using reference = value_type;
+
+			// The end of any object
+			constexpr const_iterator() noexcept = default;
+			const_iterator(const Character* opening, EscapedStrings* escapes) :
+				_escapes(escapes)
+			{
+				Next(ValueCursor::Iterator(opening + 1), true);
+			}
+
+			// A name with escapes is decoded the first time it's read, and kept by the document
+			value_type operator*() const
+			{
+				auto name = _escaped ? ParseEscapedText(_escapes->Keep(_text.data(), _text.size())) : _text;
+				return value_type(name, ValueCursor(_value, _escapes));
+			}
+			const_iterator& operator++()
+			{
+				Next(ValueCursor::Iterator(ValueCursor::Skip(_value)), false);
+				return *this;
+			}
+			const_iterator operator++(int)
+			{
+				auto previous = *this;
+				++*this;
+				return previous;
+			}
+			bool operator==(const const_iterator& rhs) const noexcept
+			{
+				return _name == rhs._name;
+			}
+			bool operator!=(const const_iterator& rhs) const noexcept
+			{
+				return _name != rhs._name;
+			}
+		};
+
+		const_iterator begin() const
+		{
+			return const_iterator(_opening, _escapes);
+		}
+		const_iterator end() const noexcept
+		{
+			return const_iterator();
+		}
+
+		const_iterator find(StringView name) const
+		{
+			auto last = end();
+			for (auto member = begin(); member != last; ++member)
+				if (member.Named(name))
+					return member;
+			return last;
+		}
+
+		ValueCursor operator[](StringView name) const
+		{
+			auto found = find(name);
+			if (found == end())
+				throw std::out_of_range("No object member with this name");
+			return (*found).second;
+		}
+	};
+
+	// The elements of an array in document order, found by walking from the opening bracket each time
+
+	class ArrayCursor
+	{
+		const Character* _opening;
+		EscapedStrings* _escapes;
+	public:
+		constexpr ArrayCursor(const Character* opening, EscapedStrings* escapes) noexcept :
+			_opening(opening),
+			_escapes(escapes)
+		{
+		}
+
+		class const_iterator
+		{
+			const Character* _at = nullptr; // The current element, or null once past the end
+			EscapedStrings* _escapes = nullptr;
+
+			// One step of ParseGrammar::Elements(), from the character following the opening bracket or an element
+			void Next(ParseIterator iterator, bool first)
+			{
+				auto character = SkipWhitespace(iterator);
+				if (first ? character == ParseArray::ClosingBracket : !ParseGrammar::MoreElements(character, iterator))
+				{
+					_at = nullptr;
+					return;
+				}
+				if (!first)
+					SkipWhitespace(++iterator);
+				_at = iterator;
+			}
+
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = ValueCursor;
+			using difference_type = std::ptrdiff_t;
+			using pointer = void;
+			using reference = value_type;
+
+			// The end of any array
+			constexpr const_iterator() noexcept = default;
+			const_iterator(const Character* opening, EscapedStrings* escapes) :
+				_escapes(escapes)
+			{
+				Next(ValueCursor::Iterator(opening + 1), true);
+			}
+
+			value_type operator*() const noexcept
+			{
+				return ValueCursor(_at, _escapes);
+			}
+			const_iterator& operator++()
+			{
+				Next(ValueCursor::Iterator(ValueCursor::Skip(_at)), false);
+				return *this;
+			}
+			const_iterator operator++(int)
+			{
+				auto previous = *this;
+				++*this;
+				return previous;
+			}
+			bool operator==(const const_iterator& rhs) const noexcept
+			{
+				return _at == rhs._at;
+			}
+			bool operator!=(const const_iterator& rhs) const noexcept
+			{
+				return _at != rhs._at;
+			}
+		};
+
+		const_iterator begin() const
+		{
+			return const_iterator(_opening, _escapes);
+		}
+		const_iterator end() const noexcept
+		{
+			return const_iterator();
+		}
+
+		// Walks the whole array
+		std::size_t size() const
+		{
+			std::size_t count = 0;
+			for (auto element = begin(); element != end(); ++element)
+				count++;
+			return count;
+		}
+		bool empty() const
+		{
+			return begin() == end();
+		}
+
+		// Steps over the preceding elements, so iterate rather than index when visiting them all
+		ValueCursor operator[](std::size_t index) const
+		{
+			auto last = end();
+			for (auto element = begin(); element != last; ++element)
+				if (!index--)
+					return *element;
+			throw std::out_of_range("Array index out of range");
+		}
+	};
+
+	inline ValueCursor ValueCursor::operator[](StringView name) const
+	{
+		return As<ObjectCursor>()[name];
+	}
+
+	inline ValueCursor ValueCursor::operator[](std::size_t index) const
+	{
+		return As<ArrayCursor>()[index];
+	}
+
+	// The root of a document read on demand, keeping any strings decoded whilst reading it.
+	// Strings with escapes are decoded the first time they're read and kept, so storage grows only with the different
+	// strings read, however often they're read again. Member names found by a search aren't decoded at all.
+
+	class DocumentCursor : public ValueCursor
+	{
+		// We never copy or move
+		void operator=(const DocumentCursor&) = delete;
+		void operator=(const DocumentCursor&&) = delete;
+		DocumentCursor(const DocumentCursor&) = delete;
+		DocumentCursor(const DocumentCursor&&) = delete;
+
+		EscapedStrings _strings;
+
+		static const Character* Root(const Character* text) noexcept
+		{
+			auto iterator = Iterator(text);
+			SkipWhitespace(iterator);
+			return iterator;
+		}
+
+	public:
+		explicit DocumentCursor(const Character* text, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) :
+			ValueCursor(Root(text), &_strings),
+			_strings(resource)
+		{
+		}
+	};
+
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include <memory>
+#include <memory_resource>
 #include "ParseToken.hpp"
 #include "ParseArray.hpp"
 #include "ParseObject.hpp"
@@ -9,14 +10,20 @@
 #include "ParseNumber.hpp"
 #include "Parse.hpp"
 #include "ParseException.hpp"
+#include "ParseStack.hpp"
+#include "ParseParallel.hpp"
+#include "ParseProjection.hpp"
 
 namespace August
 {
 
 	// The main class for parsing JSON.
-	// Parsing happens during construct from a buffer which the caller provides.
+	// Parsing happens during construct, or Reparse(), from a buffer which the caller provides.
 	// The provided buffer needs to be kept alive as long as the ParseDocument class is in use.
 	// The provided buffer also needs to be zero terminated.
+	// All object and array storage comes from a memory resource, the default heap unless one is provided.
+	// An arena such as std::pmr::monotonic_buffer_resource makes building and tearing down a document very cheap,
+	// but the resource must outlive the document.
 
 	class ParseDocument : public ParseToken
 	{
@@ -32,22 +39,175 @@ namespace August
 
 		ObjectsTable _objects;
 		ArraysTable _arrays;
+		std::unique_ptr<EscapedStrings> _escapes; // Only for read only documents
+		std::unique_ptr<std::pmr::deque<ParseTables>> _parts; // Only for documents parsed in parallel
+		std::unique_ptr<NumbersTable> _numbers; // Only for documents parsed with ParseOptions::PackedNumbers
+
+		// Packing is only by the regular parse of arrays, and gives way to ParseOptions::LazyNumbers
+		void PackNumbers(ParseContext& context)
+		{
+			if (!(context.Options & ParseOptions::PackedNumbers) || (context.Options & ParseOptions::LazyNumbers))
+				return;
+			if (!_numbers)
+				_numbers = std::make_unique<NumbersTable>(_objects.get_allocator().resource());
+			context.Numbers = _numbers.get();
+		}
 	public:
 		// The JSON source must be mutable and zero terminated
 		// Note that this constructor doesn't persist the buffer, and it needs to live as long as this instance
-		explicit ParseDocument(ParseIterator iterator)
+		explicit ParseDocument(ParseIterator iterator, ParseOptions options = ParseOptions::None, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) :
+			_objects(resource),
+			_arrays(resource)
+		{
+			_objects.reserve(DefaultTableSize);
+			_arrays.reserve(DefaultTableSize);
+			Reparse(iterator, options);
+		}
+
+		// A read only source, such as shared memory or a string literal, which still needs to be zero terminated.
+		// Strings without escape sequences refer straight into the source. Those with escapes are decoded when first read,
+		// into storage kept by this instance, and so first reads of the same string from several threads need synchronising.
+		ParseDocument(ReadOnlyBuffer, const Character* text, ParseOptions options = ParseOptions::None, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) :
+			_objects(resource),
+			_arrays(resource)
+		{
+			_objects.reserve(DefaultTableSize);
+			_arrays.reserve(DefaultTableSize);
+			Reparse(ReadOnly, text, options);
+		}
+
+		// A document of the given length that needn't be zero terminated, such as a network receive buffer, so that no copy is needed.
+		// The buffer must have at least ParsePadding bytes of writable slack beyond the length, which may be overwritten.
+		// A zero byte within the length is an error rather than the end of the document.
+		ParseDocument(ParseIterator data, std::size_t length, ParseOptions options = ParseOptions::None, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) :
+			_objects(resource),
+			_arrays(resource)
+		{
+			_objects.reserve(DefaultTableSize);
+			_arrays.reserve(DefaultTableSize);
+			Reparse(data, length, options);
+		}
+
+		// As the first, but without recursion, so nesting is limited by the stack's maximum depth rather than the thread's stack.
+		// The stack can be reused between documents.
+		ParseDocument(ParseIterator iterator, ParseStack& stack, ParseOptions options = ParseOptions::None, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) :
+			_objects(resource),
+			_arrays(resource)
+		{
+			_objects.reserve(DefaultTableSize);
+			_arrays.reserve(DefaultTableSize);
+			Reparse(iterator, stack, options);
+		}
+
+		// As the first, but a large array is split between threads, each parsing some of its elements.
+		// The memory resource must be thread safe. The parallel front end can be reused between documents.
+		ParseDocument(ParseIterator iterator, ParseParallel& parallel, ParseOptions options = ParseOptions::None, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) :
+			_objects(resource),
+			_arrays(resource)
+		{
+			_objects.reserve(DefaultTableSize);
+			_arrays.reserve(DefaultTableSize);
+			Reparse(iterator, parallel, options);
+		}
+
+		// As the first, but keeping only the values at the projection's key paths and stepping over everything else.
+		// The projection can be reused between documents.
+		ParseDocument(ParseIterator iterator, ParseProjection& projection, ParseOptions options = ParseOptions::None, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) :
+			_objects(resource),
+			_arrays(resource)
 		{
 			_objects.reserve(DefaultTableSize);
 			_arrays.reserve(DefaultTableSize);
+			Reparse(iterator, projection, options);
+		}
+
+		// Replace the content with another document, with the same requirements on the buffer as construction.
+		// The storage of every object and array is kept and reused, so a steady stream of similarly shaped documents
+		// soon needs no allocations at all. Anything read from the previous document is no longer valid.
+		void Reparse(ParseIterator iterator, ParseOptions options = ParseOptions::None)
+		{
+			Clear();
+			ParseContext context{ _objects, _arrays, options };
+			PackNumbers(context);
+			auto character = SkipWhitespace(iterator);
+			static_cast<ParseToken&>(*this) = ParseAny(context, character, iterator);
+			character = SkipWhitespace(iterator);
+			if (character)
+				throw ParseException(iterator, "Unexpected content after main document");
+		}
+
+		void Reparse(ReadOnlyBuffer, const Character* text, ParseOptions options = ParseOptions::None)
+		{
+			Clear();
+			if (!_escapes)
+				_escapes = std::make_unique<EscapedStrings>(_objects.get_allocator().resource());
+			ParseContext context{ _objects, _arrays, options };
+			PackNumbers(context);
+			context.Escapes = _escapes.get();
+			// Nothing is written to the document in this mode, so it's safe to drop the const for the iterator
+			auto iterator = const_cast<ParseIterator>(text);
 			auto character = SkipWhitespace(iterator);
-			static_cast<ParseToken&>(*this) = ParseAny(_objects, _arrays, character, iterator);
+			static_cast<ParseToken&>(*this) = ParseAny(context, character, iterator);
 			character = SkipWhitespace(iterator);
 			if (character)
 				throw ParseException(iterator, "Unexpected content after main document");
 		}
+
+		void Reparse(ParseIterator data, std::size_t length, ParseOptions options = ParseOptions::None)
+		{
+			Clear();
+			data[length] = 0;
+			auto iterator = data;
+			ParseContext context{ _objects, _arrays, options };
+			PackNumbers(context);
+			auto character = SkipWhitespace(iterator);
+			static_cast<ParseToken&>(*this) = ParseAny(context, character, iterator);
+			character = SkipWhitespace(iterator);
+			if (character || iterator != data + length)
+				throw ParseException(iterator, "Unexpected content after main document");
+		}
+
+		void Reparse(ParseIterator iterator, ParseStack& stack, ParseOptions options = ParseOptions::None)
+		{
+			Clear();
+			ParseContext context{ _objects, _arrays, options };
+			PackNumbers(context);
+			static_cast<ParseToken&>(*this) = stack.Parse(context, iterator);
+		}
+
+		void Reparse(ParseIterator iterator, ParseParallel& parallel, ParseOptions options = ParseOptions::None)
+		{
+			Clear();
+			if (!_parts)
+				_parts = std::make_unique<std::pmr::deque<ParseTables>>(_objects.get_allocator().resource());
+			ParseContext context{ _objects, _arrays, options };
+			PackNumbers(context);
+			static_cast<ParseToken&>(*this) = parallel.Parse(context, *_parts, iterator);
+		}
+
+		void Reparse(ParseIterator iterator, ParseProjection& projection, ParseOptions options = ParseOptions::None)
+		{
+			Clear();
+			ParseContext context{ _objects, _arrays, options };
+			PackNumbers(context);
+			static_cast<ParseToken&>(*this) = projection.Parse(context, iterator);
+		}
+
+		// Leaves the document as null, no longer referring to its buffer, whilst keeping all storage for the next Reparse()
+		void Clear() noexcept
+		{
+			static_cast<ParseToken&>(*this) = ParseToken();
+			if (_escapes)
+			{
+				_escapes->Strings.clear();
+				_escapes->Decoded.release();
+			}
+			if (_numbers)
+				_numbers->clear();
+		}
 	};
 
-	inline ParseToken ParseAny(ObjectsTable& objects, ArraysTable& arrays, Character character, ParseIterator& iterator)
+	inline ParseToken ParseAny(ParseContext& context, Character character, ParseIterator& iterator)
 	{
 		switch (character)
 		{
@@ -55,13 +215,13 @@ namespace August
 			return ParseNull::Parse(iterator);
 
 		case ParseObject::OpeningBraces:
-			return ParseObject::Parse(objects, arrays, iterator);
+			return ParseObject::Parse(context, iterator);
 
 		case ParseArray::OpeningBracket:
-			return ParseArray::Parse(objects, arrays, iterator);
+			return ParseArray::Parse(context, iterator);
 
 		case ParseString::Quotes:
-			return ParseString::Parse(iterator);
+			return ParseString::Parse(context, iterator);
 
 		case ParseBoolean::FirstTrueCharacter:
 			return ParseBoolean::ParseTrue(iterator);
@@ -70,6 +230,8 @@ namespace August
 			return ParseBoolean::ParseFalse(iterator);
 
 		default:
+			if (context.Options & ParseOptions::LazyNumbers)
+				return ParseNumber::ParseText(character, iterator);
 			return ParseNumber::Parse(character, iterator);
 		}
 	}
@@ -0,0 +1,102 @@
+#pragma once
+#include "Parse.hpp"
+#include "ParseToken.hpp"
+#include "ParseObject.hpp"
+#include "ParseArray.hpp"
+#include "ParseString.hpp"
+#include "ParseBoolean.hpp"
+#include "ParseNull.hpp"
+#include "ParseNumber.hpp"
+#include "ParseGrammar.hpp"
+#include "ParseException.hpp"
+
+namespace August
+{
+
+	// Parsing without building a document, instead calling the handler as each part of the document is met.
+	// It's the plainest front end on ParseGrammar, the one the others are variations of.
+	// Nothing is allocated, so documents far larger than their equivalent tables can be aggregated or filtered.
+	// The handler is any class with these methods, resolved at compile time:
+	//     void StartObject();
+	//     void Key(StringView name); // Before the value of each member
+	//     void EndObject();
+	//     void StartArray();
+	//     void EndArray();
+	//     void Value(const ParseToken& value); // Any string, number, boolean or null
+	// Strings passed to the handler refer into the buffer, which has the same requirements as for ParseDocument.
+	// Any error throws a ParseException, though the handler will have already seen everything before it.
+
+	template<class Handler_>
+	class ParseEvents
+	{
+		// We never copy or move
+		void operator=(const ParseEvents&) = delete;
+		void operator=(const ParseEvents&&) = delete;
+		ParseEvents(const ParseEvents&) = delete;
+		ParseEvents(const ParseEvents&&) = delete;
+
+		Handler_& _handler;
+		ParseOptions _options;
+
+		void ParseValue(Character character, ParseIterator& iterator)
+		{
+			switch (character)
+			{
+			case ParseObject::OpeningBraces:
+				_handler.StartObject();
+				ParseGrammar::Object(iterator, ParseGrammar::InPlaceNames(), [this](StringView name, Character next, ParseIterator& at)
+				{
+					_handler.Key(name);
+					ParseValue(next, at);
+				});
+				_handler.EndObject();
+				break;
+
+			case ParseArray::OpeningBracket:
+				_handler.StartArray();
+				ParseGrammar::Array(iterator, [this](Character next, ParseIterator& at)
+				{
+					ParseValue(next, at);
+				});
+				_handler.EndArray();
+				break;
+
+			case ParseNull::FirstCharacter:
+				_handler.Value(ParseNull::Parse(iterator));
+				break;
+
+			case ParseString::Quotes:
+				_handler.Value(ParseString::Parse(iterator));
+				break;
+
+			case ParseBoolean::FirstTrueCharacter:
+				_handler.Value(ParseBoolean::ParseTrue(iterator));
+				break;
+
+			case ParseBoolean::FirstFalseCharacter:
+				_handler.Value(ParseBoolean::ParseFalse(iterator));
+				break;
+
+			default:
+				if (_options & ParseOptions::LazyNumbers)
+					_handler.Value(ParseNumber::ParseText(character, iterator));
+				else
+					_handler.Value(ParseNumber::Parse(character, iterator));
+				break;
+			}
+		}
+
+	public:
+		// Parsing happens during construct, and the handler has seen the whole document once it completes
+		ParseEvents(ParseIterator iterator, Handler_& handler, ParseOptions options = ParseOptions::None) :
+			_handler(handler),
+			_options(options)
+		{
+			ParseGrammar::Document(iterator, [this](Character next, ParseIterator& at)
+			{
+				ParseValue(next, at);
+			});
+		}
+	};
+
+}
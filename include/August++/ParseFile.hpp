@@ -0,0 +1,139 @@
+#pragma once
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <system_error>
+#include <cerrno>
+#include "ParseDocument.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define AUGUST_MAPPED_FILES 1
+#endif
+
+namespace August
+{
+
+	// The contents of a file, followed by the padding a length delimited parse needs.
+	// Where available the file is memory mapped copy-on-write, so pages are only read as the parse reaches them
+	// and strings can still be unescaped in place without changing the file. Elsewhere it's read into memory.
+
+	class ParseFileBuffer
+	{
+		// We never copy or move
+		void operator=(const ParseFileBuffer&) = delete;
+		void operator=(const ParseFileBuffer&&) = delete;
+		ParseFileBuffer(const ParseFileBuffer&) = delete;
+		ParseFileBuffer(const ParseFileBuffer&&) = delete;
+
+		Character* _data = nullptr;
+		std::size_t _size = 0;
+#if defined(AUGUST_MAPPED_FILES)
+		std::size_t _mapped = 0;
+
+		// Takes the error number, as closing the file on the way out may change errno
+		[[noreturn]] static void Fail(const std::filesystem::path& path, int error)
+		{
+			throw std::system_error(error, std::generic_category(), "Unable to map " + path.string());
+		}
+#else
+		std::unique_ptr<Character[]> _contents;
+#endif
+
+	public:
+		explicit ParseFileBuffer(const std::filesystem::path& path)
+		{
+#if defined(AUGUST_MAPPED_FILES)
+			auto file = ::open(path.c_str(), O_RDONLY);
+			if (file < 0)
+				Fail(path, errno);
+			struct stat status;
+			if (::fstat(file, &status) != 0)
+			{
+				auto error = errno;
+				::close(file);
+				Fail(path, error);
+			}
+			_size = static_cast<std::size_t>(status.st_size);
+
+			// Reserve enough zeroed memory for the file and padding, then map the file over the start of it.
+			// Whatever follows the end of the file, in its last page or beyond, is zero.
+			auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+			_mapped = (_size + ParsePadding + page - 1) / page * page;
+			auto reserved = ::mmap(nullptr, _mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (reserved == MAP_FAILED)
+			{
+				auto error = errno;
+				::close(file);
+				Fail(path, error);
+			}
+			if (_size && ::mmap(reserved, _size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, file, 0) == MAP_FAILED)
+			{
+				auto error = errno;
+				::munmap(reserved, _mapped);
+				::close(file);
+				Fail(path, error);
+			}
+			::close(file); // The mapping keeps its own reference
+			_data = static_cast<Character*>(reserved);
+
+			// The parse reads from start to end just the once
+			::madvise(reserved, _mapped, MADV_SEQUENTIAL);
+#else
+			std::ifstream file(path, std::ios::in | std::ios::binary);
+			if (!file)
+				throw std::system_error(std::make_error_code(std::errc::no_such_file_or_directory), "Unable to read " + path.string());
+			_size = static_cast<std::size_t>(std::filesystem::file_size(path));
+			_contents = std::make_unique<Character[]>(_size + ParsePadding);
+			_data = _contents.get();
+			file.read(reinterpret_cast<char*>(_data), static_cast<std::streamsize>(_size));
+			// A short read would otherwise leave zeros that only show up as a parse error
+			if (static_cast<std::size_t>(file.gcount()) != _size)
+				throw std::system_error(std::make_error_code(std::errc::io_error), "Unable to read " + path.string());
+#endif
+		}
+
+		~ParseFileBuffer()
+		{
+#if defined(AUGUST_MAPPED_FILES)
+			if (_data)
+				::munmap(_data, _mapped);
+#endif
+		}
+
+		// Once parsed, anything read will be wherever the lookups lead
+		void FinishedReading() noexcept
+		{
+#if defined(AUGUST_MAPPED_FILES)
+			::madvise(_data, _mapped, MADV_NORMAL);
+#endif
+		}
+
+		Character* Data() const noexcept
+		{
+			return _data;
+		}
+		std::size_t Size() const noexcept
+		{
+			return _size;
+		}
+	};
+
+	// A document parsed from a file, owning the file's contents for as long as the document is in use.
+	// The file itself is never changed.
+
+	class ParseFile : private ParseFileBuffer, public ParseDocument
+	{
+	public:
+		explicit ParseFile(const std::filesystem::path& path, ParseOptions options = ParseOptions::None, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) :
+			ParseFileBuffer(path),
+			ParseDocument(ParseFileBuffer::Data(), ParseFileBuffer::Size(), options, resource)
+		{
+			FinishedReading();
+		}
+	};
+
+}
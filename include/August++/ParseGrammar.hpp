@@ -0,0 +1,186 @@
+#pragma once
+#include <cassert>
+#include <utility> // std::forward<>
+#include <type_traits>
+#include "Parse.hpp"
+#include "ParseString.hpp"
+#include "ParseObject.hpp"
+#include "ParseArray.hpp"
+#include "ParseException.hpp"
+
+// The walks below are called from one place each with their own sinks, which compilers don't always inline,
+// and as the front ends recurse through them that would cost a second call for every level of nesting
+#if defined(__GNUC__) || defined(__clang__)
+#define AUGUST_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define AUGUST_INLINE __forceinline
+#else
+#define AUGUST_INLINE inline
+#endif
+
+namespace August
+{
+
+	// The grammar of objects and arrays, shared by the front ends. The regular parse in ParseObject and ParseArray keeps
+	// its own loops, which measured faster than the walks even when inlined, and the markers are theirs.
+	// A walk is parameterised on a scanner, called with the iterator at the opening quotes of a member name to read it,
+	// and a sink, called with the first character of each member's or element's value to read or step over it,
+	// leaving the iterator following it. A sink returning bool can stop early by returning false, having left the
+	// iterator wherever the walk should end. The checks between values are available on their own for the parsers
+	// that can't recurse, so that every front end reports the same errors at the same places.
+
+	class ParseGrammar
+	{
+		// We never instance, copy or move
+		void operator=(const ParseGrammar&) = delete;
+		void operator=(const ParseGrammar&&) = delete;
+		ParseGrammar() = delete;
+		ParseGrammar(const ParseGrammar&) = delete;
+		ParseGrammar(const ParseGrammar&&) = delete;
+
+		template<class Sink_, class... Arguments_>
+		static bool Continue(Sink_& sink, Arguments_&&... arguments)
+		{
+			if constexpr (std::is_void<decltype(sink(std::forward<Arguments_>(arguments)...))>::value)
+			{
+				sink(std::forward<Arguments_>(arguments)...);
+				return true;
+			}
+			else
+				return sink(std::forward<Arguments_>(arguments)...);
+		}
+
+	public:
+		// Member names unescaped in place, as views into the buffer
+		struct InPlaceNames
+		{
+			StringView operator()(ParseIterator& iterator) const
+			{
+				return ParseString::ParseToView(iterator);
+			}
+		};
+
+		static void CheckMemberName(Character character, const Character* where)
+		{
+			if (character != ParseString::Quotes)
+				throw ParseException(where, "Expecting opening quotes for a member name");
+		}
+
+		static void CheckNameSeparator(Character character, const Character* where)
+		{
+			if (character != ParseObject::NameSeparator)
+				throw ParseException(where, "Expecting ':' following object member name");
+		}
+
+		// Following the value of a member, true for the comma before another and false for the end of the object
+		static bool MoreMembers(Character character, const Character* where)
+		{
+			if (character == ParseObject::ClosingBraces)
+				return false;
+			if (character != ParseObject::Comma)
+				throw ParseException(where, "Expecting ',' between object members");
+			return true;
+		}
+
+		// Following an element, true for the comma before another and false for the end of the array
+		static bool MoreElements(Character character, const Character* where)
+		{
+			if (character == ParseArray::ClosingBracket)
+				return false;
+			if (character != ParseArray::CommaSeparator)
+				throw ParseException(where, "Expecting comma separating array elements or closing bracket");
+			return true;
+		}
+
+		// A member name and its separator, returning the first character of its value
+		template<class Scanner_>
+		static Character MemberName(ParseIterator& iterator, Character character, Scanner_&& scanner, StringView& name)
+		{
+			CheckMemberName(character, iterator);
+			name = scanner(iterator);
+			character = SkipWhitespace(iterator);
+			CheckNameSeparator(character, iterator);
+			iterator++;
+			return SkipWhitespace(iterator);
+		}
+
+		// The members of an object, from the first character following the opening brace.
+		// The sink is called with the name, the first character of the value and the iterator.
+		template<class Scanner_, class Sink_>
+		AUGUST_INLINE static void Members(ParseIterator& iterator, Character character, Scanner_&& scanner, Sink_&& sink)
+		{
+			if (character == ParseObject::ClosingBraces)
+			{
+				iterator++; // Empty object
+				return;
+			}
+			for (;;)
+			{
+				CheckMemberName(character, iterator);
+				auto name = scanner(iterator);
+				character = SkipWhitespace(iterator);
+				CheckNameSeparator(character, iterator);
+				character = SkipWhitespace(++iterator);
+				if (!Continue(sink, name, character, iterator))
+					return;
+				character = SkipWhitespace(iterator);
+				auto more = MoreMembers(character, iterator);
+				iterator++;
+				if (!more)
+					return;
+				character = SkipWhitespace(iterator);
+			}
+		}
+
+		template<class Scanner_, class Sink_>
+		AUGUST_INLINE static void Object(ParseIterator& iterator, Scanner_&& scanner, Sink_&& sink)
+		{
+			assert(*iterator == ParseObject::OpeningBraces);
+			auto character = SkipWhitespace(++iterator);
+			Members(iterator, character, scanner, sink);
+		}
+
+		// The elements of an array, from the first character following the opening bracket.
+		// The sink is called with the first character of each element and the iterator.
+		template<class Sink_>
+		AUGUST_INLINE static void Elements(ParseIterator& iterator, Character character, Sink_&& sink)
+		{
+			if (character == ParseArray::ClosingBracket)
+			{
+				iterator++; // Empty array
+				return;
+			}
+			for (;;)
+			{
+				if (!Continue(sink, character, iterator))
+					return;
+				character = SkipWhitespace(iterator);
+				auto more = MoreElements(character, iterator);
+				iterator++;
+				if (!more)
+					return;
+				character = SkipWhitespace(iterator);
+			}
+		}
+
+		template<class Sink_>
+		AUGUST_INLINE static void Array(ParseIterator& iterator, Sink_&& sink)
+		{
+			assert(*iterator == ParseArray::OpeningBracket);
+			auto character = SkipWhitespace(++iterator);
+			Elements(iterator, character, sink);
+		}
+
+		// The root value, which must be followed by nothing but whitespace up to the zero terminator
+		template<class Sink_>
+		static void Document(ParseIterator& iterator, Sink_&& sink)
+		{
+			auto character = SkipWhitespace(iterator);
+			sink(character, iterator);
+			character = SkipWhitespace(iterator);
+			if (character)
+				throw ParseException(iterator, "Unexpected content after main document");
+		}
+	};
+
+}
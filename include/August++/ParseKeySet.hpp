@@ -0,0 +1,165 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <stdexcept> // std::invalid_argument
+#include <type_traits>
+#include "StringType.hpp"
+#include "ParseMembers.hpp" // ParseKey::Hash()
+
+namespace August
+{
+
+	// A fixed set of member names, such as the fields a switch handles, with a perfect hash found for them at compile time.
+	// The hash first tries a name's length and two of its bytes, one counted from the start and one from the end,
+	// chosen along with a multiplier so that no two names of the set share a slot. Find() then costs a multiply, a table
+	// read and a single comparison to confirm the name, so any other name is always NoMatch. Names that differ only
+	// further in are hashed whole instead, and should that still not separate them they're probed for from their slot.
+	// It takes any StringView, so works as well on the members of a ParseObject as on names met by ParseEvents,
+	// ParseChunks or a cursor:
+	//     static constexpr August::ParseKeySet fields{ u8"id"sv, u8"name"sv, u8"price"sv };
+	//     switch (fields.Find(member.first)) { case 0: ...; case 1: ...; case 2: ...; default: ...; }
+	// Only duplicate names throw std::invalid_argument, a compile error when constexpr.
+
+	template<std::size_t Count_>
+	class ParseKeySet
+	{
+		static_assert(Count_ > 0, "A key set needs at least one name");
+
+		// Bytes within this far of either end are tried, as names most often differ near their start or end
+		static constexpr std::size_t Positions = 4;
+		// Multipliers tried for each choice of bytes and table size
+		static constexpr std::size_t Multipliers = 32;
+		// Tables up to this many times larger than the smallest that could fit are tried
+		static constexpr unsigned ExtraBits = 3;
+
+		static constexpr unsigned MinimumBits()
+		{
+			unsigned bits = 1;
+			while ((std::size_t(1) << bits) < Count_)
+				bits++;
+			return bits;
+		}
+
+		static constexpr std::size_t TableSize = std::size_t(1) << (MinimumBits() + ExtraBits);
+		using Slot = typename std::conditional<(Count_ < 255), std::uint8_t, std::uint16_t>::type;
+
+		std::array<StringView, Count_> _names{};
+		std::array<Slot, TableSize> _slots{}; // The position of the name in each slot plus one, or zero where empty
+		std::uint32_t _multiplier = 0;
+		unsigned _shift = 0;
+		std::size_t _first = 0; // From the start
+		std::size_t _last = 0; // From the end
+		bool _whole = false; // Hashing the whole name rather than two of its bytes
+		bool _probed = false; // Names that share a slot follow it, so aren't always found at the first
+
+		constexpr std::uint32_t Select(StringView name) const noexcept
+		{
+			if (_whole)
+			{
+				auto hash = ParseKey::Hash(name);
+				return static_cast<std::uint32_t>(hash ^ hash >> 32);
+			}
+			auto size = name.size();
+			std::uint32_t start = size > _first ? static_cast<unsigned char>(name[_first]) : 0;
+			std::uint32_t end = size > _last ? static_cast<unsigned char>(name[size - 1 - _last]) : 0;
+			return static_cast<std::uint32_t>(size) << 16 ^ start << 8 ^ end;
+		}
+
+		constexpr std::size_t SlotOf(StringView name) const noexcept
+		{
+			return static_cast<std::size_t>((Select(name) * _multiplier) >> _shift);
+		}
+
+		// Fill the table with the current choices, returning false where two names share a slot unless probing
+		constexpr bool Place() noexcept
+		{
+			for (std::size_t slot = 0; slot < TableSize; slot++)
+				_slots[slot] = 0;
+			for (std::size_t name = 0; name < Count_; name++)
+			{
+				auto slot = SlotOf(_names[name]);
+				while (_slots[slot])
+				{
+					if (!_probed)
+						return false;
+					slot = (slot + 1) & (TableSize - 1);
+				}
+				_slots[slot] = static_cast<Slot>(name + 1);
+			}
+			return true;
+		}
+
+		// Every choice of multiplier, for each table size, until the names each have a slot of their own
+		constexpr bool PlaceAny() noexcept
+		{
+			for (auto bits = MinimumBits(); bits <= MinimumBits() + ExtraBits; bits++)
+			{
+				_shift = 32 - bits;
+				std::uint32_t multiplier = 0x9E3779B1u;
+				for (std::size_t attempt = 0; attempt < Multipliers; attempt++)
+				{
+					_multiplier = multiplier;
+					if (Place())
+						return true;
+					multiplier = (multiplier * 0x2545F491u + 0x6A09E667u) | 1;
+				}
+			}
+			return false;
+		}
+
+	public:
+		// Returned by Find() for any name not in the set
+		static constexpr std::size_t NoMatch = Count_;
+
+		template<class... Names_>
+		constexpr explicit ParseKeySet(Names_... names) :
+			_names{ StringView(names)... }
+		{
+			static_assert(sizeof...(Names_) == Count_, "Give exactly as many names as the set holds");
+			for (std::size_t name = 1; name < Count_; name++)
+				for (std::size_t other = 0; other < name; other++)
+					if (_names[name] == _names[other])
+						throw std::invalid_argument("Duplicate name in a key set");
+			for (_first = 0; _first < Positions; _first++)
+				for (_last = 0; _last < Positions; _last++)
+					if (PlaceAny())
+						return;
+			_whole = true;
+			if (PlaceAny())
+				return;
+			// Over 8 times as many slots as names, so few are probed past
+			_probed = true;
+			_shift = 32 - (MinimumBits() + ExtraBits);
+			Place();
+		}
+
+		// The position of the name in the set, or NoMatch
+		constexpr std::size_t Find(StringView name) const noexcept
+		{
+			for (auto position = SlotOf(name);; position = (position + 1) & (TableSize - 1))
+			{
+				auto slot = _slots[position];
+				if (!slot)
+					return NoMatch;
+				if (_names[slot - 1] == name)
+					return slot - 1;
+				if (!_probed)
+					return NoMatch;
+			}
+		}
+
+		constexpr std::size_t size() const noexcept
+		{
+			return Count_;
+		}
+
+		constexpr StringView operator[](std::size_t position) const noexcept
+		{
+			return _names[position];
+		}
+	};
+
+	template<class... Names_>
+	ParseKeySet(Names_...) -> ParseKeySet<sizeof...(Names_)>;
+
+}
@@ -0,0 +1,250 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <memory>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include "Parse.hpp"
+#include "ParseSimd.hpp"
+#include "ParseDocument.hpp"
+#include "ParseException.hpp"
+
+namespace August
+{
+
+	// Whether ParseLines gives records to the handler in the order they appear
+	enum class LineOrder
+	{
+		InOrder, // One at a time from the calling thread
+		Unordered // From the worker threads as soon as each is parsed, so the handler must be thread safe
+	};
+
+	// A reader for JSON Lines (NDJSON), where each line of the buffer is a document of its own.
+	// A line feed can't appear unescaped within a valid document, so records are split on every one found,
+	// a vector at a time. Records are then handed out in batches to worker threads, each parsed in place as for
+	// ParseDocument, with the line feed that ends it overwritten as its zero terminator. Blank lines are skipped.
+	// The handler is anything callable as handler(std::size_t line, ParseDocument& record), with the zero based line number.
+	// Each record, and anything read from it, is only valid during the call, as its storage is reused for later records.
+	// An instance keeps that storage between buffers too. Any error stops the reading and is rethrown from Parse(),
+	// after every record before it has been given when in order.
+
+	class ParseLines
+	{
+		// We never copy or move, but do reuse
+		void operator=(const ParseLines&) = delete;
+		void operator=(const ParseLines&&) = delete;
+		ParseLines(const ParseLines&) = delete;
+		ParseLines(const ParseLines&&) = delete;
+
+		struct Record
+		{
+			ParseIterator Start;
+			std::size_t Line;
+		};
+
+		// Consecutive records handed to a worker at once
+		struct Batch
+		{
+			std::vector<Record> Records;
+			std::vector<std::unique_ptr<ParseDocument>> Documents; // Reused for the records of every batch in this slot
+			std::size_t Parsed = 0; // Records before any error
+			bool Done = false;
+
+			// ParseException can't be copied so is carried as its parts
+			const Character* ErrorWhere = nullptr;
+			std::string ErrorMessage;
+			std::exception_ptr Error;
+		};
+
+		// Enough records for a worker that handing over the batch is a small part of the work
+		static constexpr std::size_t BatchBytes = 64 * 1024;
+		// Batches in flight per worker, so workers needn't wait on the order records are given in
+		static constexpr std::size_t BatchesPerThread = 4;
+
+		std::size_t _threads;
+		ParseOptions _options;
+		std::vector<Batch> _batches; // A ring of those in flight
+
+		// The records of the next batch, returning where the following batch starts
+		static ParseIterator Split(ParseIterator at, ParseIterator end, std::size_t& line, Batch& batch)
+		{
+			batch.Records.clear();
+			auto limit = at + BatchBytes;
+			while (at != end && (at < limit || batch.Records.empty()))
+			{
+				auto lineFeed = ParseSimd::FindLineFeed(at, end);
+				*lineFeed = 0; // Either the line feed or the byte after the buffer
+				auto start = at;
+				if (SkipWhitespace(start))
+					batch.Records.push_back(Record{ at, line });
+				line++;
+				at = lineFeed == end ? end : lineFeed + 1;
+			}
+			return at;
+		}
+
+		template<class Handler_>
+		void ParseBatch(Batch& batch, Handler_& handler, bool giveEach)
+		{
+			try
+			{
+				for (; batch.Parsed < batch.Records.size(); batch.Parsed++)
+				{
+					auto& record = batch.Records[batch.Parsed];
+					if (batch.Parsed < batch.Documents.size())
+						batch.Documents[batch.Parsed]->Reparse(record.Start, _options);
+					else
+						batch.Documents.push_back(std::make_unique<ParseDocument>(record.Start, _options));
+					if (giveEach)
+						handler(record.Line, *batch.Documents[batch.Parsed]);
+				}
+			}
+			catch (const ParseException& error)
+			{
+				batch.ErrorWhere = error.Where;
+				batch.ErrorMessage = error.what();
+			}
+			catch (...)
+			{
+				batch.Error = std::current_exception();
+			}
+		}
+
+		static void Rethrow(Batch& batch)
+		{
+			if (batch.ErrorWhere)
+				throw ParseException(batch.ErrorWhere, batch.ErrorMessage.c_str());
+			if (batch.Error)
+				std::rethrow_exception(batch.Error);
+		}
+
+		static void Reset(Batch& batch)
+		{
+			batch.Parsed = 0;
+			batch.Done = false;
+			batch.ErrorWhere = nullptr;
+			batch.Error = nullptr;
+		}
+
+	public:
+		explicit ParseLines(std::size_t threads = std::thread::hardware_concurrency(), ParseOptions options = ParseOptions::None) :
+			_threads(threads),
+			_options(options)
+		{
+		}
+
+		std::size_t Threads() const noexcept
+		{
+			return _threads;
+		}
+
+		// Read every record of the buffer, which must be mutable and followed by at least ParsePadding writable bytes,
+		// the first of which is overwritten as the terminator of the last line. Workers only last for the call.
+		template<class Handler_>
+		void Parse(ParseIterator data, std::size_t length, Handler_&& handler, LineOrder order = LineOrder::InOrder)
+		{
+			auto end = data + length;
+			std::size_t line = 0;
+			if (_threads <= 1)
+			{
+				// The calling thread does everything, a batch at a time
+				_batches.resize(1);
+				auto& batch = _batches.front();
+				while (data != end)
+				{
+					Reset(batch);
+					data = Split(data, end, line, batch);
+					ParseBatch(batch, handler, true);
+					Rethrow(batch);
+				}
+				return;
+			}
+
+			_batches.resize(_threads * BatchesPerThread);
+			std::mutex mutex;
+			std::condition_variable queued, parsed;
+			std::deque<Batch*> queue;
+			auto stopping = false;
+			auto unordered = order == LineOrder::Unordered;
+			std::vector<std::thread> workers;
+
+			// Workers are stopped however the reading ends, including by the handler throwing
+			struct Stop
+			{
+				std::mutex& Mutex;
+				std::condition_variable& Queued;
+				bool& Stopping;
+				std::vector<std::thread>& Workers;
+				~Stop()
+				{
+					{
+						std::lock_guard<std::mutex> lock(Mutex);
+						Stopping = true;
+					}
+					Queued.notify_all();
+					for (auto& worker : Workers)
+						worker.join();
+				}
+			} stop{ mutex, queued, stopping, workers };
+
+			for (std::size_t i = 0; i < _threads; i++)
+			{
+				workers.emplace_back([&]
+				{
+					for (;;)
+					{
+						Batch* batch;
+						{
+							std::unique_lock<std::mutex> lock(mutex);
+							queued.wait(lock, [&] { return stopping || !queue.empty(); });
+							if (stopping)
+								return;
+							batch = queue.front();
+							queue.pop_front();
+						}
+						ParseBatch(*batch, handler, unordered);
+						{
+							std::lock_guard<std::mutex> lock(mutex);
+							batch->Done = true;
+						}
+						parsed.notify_all();
+					}
+				});
+			}
+
+			// Keep the ring full, then take back batches in the order they were handed out
+			std::size_t handedOut = 0, takenBack = 0;
+			while (data != end || takenBack != handedOut)
+			{
+				if (data != end && handedOut - takenBack < _batches.size())
+				{
+					auto& batch = _batches[handedOut++ % _batches.size()];
+					Reset(batch);
+					data = Split(data, end, line, batch);
+					{
+						std::lock_guard<std::mutex> lock(mutex);
+						queue.push_back(&batch);
+					}
+					queued.notify_one();
+					continue;
+				}
+
+				auto& batch = _batches[takenBack++ % _batches.size()];
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+					parsed.wait(lock, [&] { return batch.Done; });
+				}
+				if (!unordered)
+				{
+					for (std::size_t i = 0; i < batch.Parsed; i++)
+						handler(batch.Records[i].Line, *batch.Documents[i]);
+				}
+				Rethrow(batch);
+			}
+		}
+	};
+
+}
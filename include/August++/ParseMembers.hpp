@@ -0,0 +1,206 @@
+#pragma once
+#include <vector>
+#include <memory_resource>
+#include <utility> // std::pair<>
+#include <algorithm>
+#include <stdexcept> // std::out_of_range
+#include <cstdint>
+#include "StringType.hpp"
+
+namespace August
+{
+
+	// A member name for repeated lookups, with its hash worked out once up front.
+	// Construct these once (they can be constexpr) for the names looked up in many objects.
+
+	class ParseKey
+	{
+		StringView _name;
+		std::uint64_t _hash;
+	public:
+		// 64 bit FNV-1a, which is cheap for the short names typical of JSON
+		static constexpr std::uint64_t Hash(StringView name) noexcept
+		{
+			std::uint64_t hash = 0xcbf29ce484222325ull;
+			for (auto character : name)
+			{
+				hash ^= static_cast<unsigned char>(character);
+				hash *= 0x100000001b3ull;
+			}
+			return hash;
+		}
+
+		explicit constexpr ParseKey(StringView name) noexcept :
+			_name(name),
+			_hash(Hash(name))
+		{
+		}
+
+		constexpr StringView Name() const noexcept
+		{
+			return _name;
+		}
+		constexpr std::uint64_t HashValue() const noexcept
+		{
+			return _hash;
+		}
+	};
+
+	// Storage for the members of an object, kept contiguously in document order.
+	// Most objects are small enough that a linear scan of the names is quicker than any tree or hash,
+	// so only larger objects get a side hash index of their names. It's built once the object is complete,
+	// so lookups only ever read and a parsed document can be shared between threads.
+	// Names aren't required to be unique; lookup always finds the first member with a name.
+	// A template only so that it can be declared ahead of the token type it holds.
+	// All storage, including the indexes, comes from the memory resource of the document's tables.
+
+	template<class Token_>
+	class ObjectMembers
+	{
+	public:
+		using value_type = std::pair<StringView, Token_>;
+		using const_iterator = typename std::pmr::vector<value_type>::const_iterator;
+		using iterator = const_iterator;
+		using allocator_type = std::pmr::polymorphic_allocator<value_type>;
+
+		// Objects with more members than this are given a hash index once complete
+		static constexpr std::size_t HashThreshold = 8;
+
+	private:
+		std::pmr::vector<value_type> _members;
+
+		// Open addressed with linear probing, so duplicate names are found in document order
+		struct HashSlot
+		{
+			std::uint32_t Hash; // Low bits of the name's hash
+			std::uint32_t Position; // Member position + 1, or 0 when unused
+		};
+		std::pmr::vector<HashSlot> _hashed; // Empty when not indexed
+
+		void BuildHashIndex()
+		{
+			std::size_t slots = 1;
+			while (slots < _members.size() * 2)
+				slots <<= 1;
+			auto& hashed = _hashed;
+			hashed.assign(slots, HashSlot{ 0, 0 });
+			auto mask = slots - 1;
+			for (std::size_t position = 0; position < _members.size(); position++)
+			{
+				auto hash = ParseKey::Hash(_members[position].first);
+				auto slot = static_cast<std::size_t>(hash) & mask;
+				while (hashed[slot].Position)
+					slot = (slot + 1) & mask;
+				hashed[slot] = HashSlot{ static_cast<std::uint32_t>(hash), static_cast<std::uint32_t>(position + 1) };
+			}
+		}
+
+	public:
+		// Allocator aware so that a table of these passes its memory resource on
+		explicit ObjectMembers(const allocator_type& allocator = {}) :
+			_members(allocator),
+			_hashed(allocator)
+		{
+		}
+		ObjectMembers(ObjectMembers&& rhs) noexcept = default;
+		ObjectMembers(ObjectMembers&& rhs, const allocator_type& allocator) :
+			_members(std::move(rhs._members), allocator),
+			_hashed(std::move(rhs._hashed), allocator)
+		{
+		}
+
+		void reserve(std::size_t size)
+		{
+			_members.reserve(size);
+		}
+
+		// Empties whilst keeping capacity for reuse
+		void clear() noexcept
+		{
+			_members.clear();
+			_hashed.clear();
+		}
+
+		void emplace(StringView name, const Token_& token)
+		{
+			_members.emplace_back(name, token);
+		}
+
+		// Called once all members have been added
+		void Complete()
+		{
+			if (_members.size() > HashThreshold)
+				BuildHashIndex();
+		}
+
+		std::size_t size() const noexcept
+		{
+			return _members.size();
+		}
+		bool empty() const noexcept
+		{
+			return _members.empty();
+		}
+		const_iterator begin() const noexcept
+		{
+			return _members.begin();
+		}
+		const_iterator end() const noexcept
+		{
+			return _members.end();
+		}
+
+		const_iterator find(StringView name) const
+		{
+			if (!_hashed.empty())
+				return find(ParseKey(name));
+			for (auto member = _members.begin(); member != _members.end(); ++member)
+				if (member->first == name)
+					return member;
+			return _members.end();
+		}
+
+		const_iterator find(const ParseKey& key) const
+		{
+			if (_hashed.empty())
+			{
+				for (auto member = _members.begin(); member != _members.end(); ++member)
+					if (member->first == key.Name())
+						return member;
+				return _members.end();
+			}
+			auto hash = static_cast<std::uint32_t>(key.HashValue());
+			auto mask = _hashed.size() - 1;
+			for (auto slot = static_cast<std::size_t>(key.HashValue()) & mask;; slot = (slot + 1) & mask)
+			{
+				auto& entry = _hashed[slot];
+				if (!entry.Position)
+					return _members.end();
+				if (entry.Hash == hash && _members[entry.Position - 1].first == key.Name())
+					return _members.begin() + (entry.Position - 1);
+			}
+		}
+
+		// As std::map, either 0 or 1 regardless of duplicates
+		std::size_t count(StringView name) const
+		{
+			return find(name) == end() ? 0 : 1;
+		}
+
+		const Token_& at(StringView name) const
+		{
+			auto found = find(name);
+			if (found == end())
+				throw std::out_of_range("No object member with this name");
+			return found->second;
+		}
+		const Token_& at(const ParseKey& key) const
+		{
+			auto found = find(key);
+			if (found == end())
+				throw std::out_of_range("No object member with this name");
+			return found->second;
+		}
+	};
+
+}
@@ -1,16 +1,26 @@
 #pragma once
 #include <cassert>
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <limits>
+#include <charconv> // std::from_chars
 #include "Parse.hpp"
 #include "ParseToken.hpp"
 #include "ParseException.hpp"
 #include "PowerOf10.hpp"
+#include "PowerOf5.hpp"
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 namespace August
 {
 
 	// Providing parsing of a number. Numbers can be integer or floating point
 	// depending upon the presence of a decimal point or exponent.
-	// The rest of the time for querying, all functionality is in the base class std::map<StringView, ParseToken>
+	// Integers too large for std::int64_t are promoted to std::uint64_t and then to double.
+	// Floating point values are correctly rounded: exactly representable cases are calculated directly (Clinger),
+	// the rest with a 128 bit approximation (Eisel-Lemire), and the very rare undecidable cases with std::from_chars.
 
 	class ParseNumber
 	{
@@ -30,6 +40,197 @@ namespace August
 			return character >= '0' && character <= '9';
 		}
 
+		// Any 19 decimal digits fit in 64 bits
+		static constexpr int MaximumMantissaDigits = 19;
+
+		// Exponents beyond this are out of range for a double whatever the mantissa, so we stop accumulating
+		static constexpr int MaximumExponent = 100000;
+
+		struct Product
+		{
+			std::uint64_t Low;
+			std::uint64_t High;
+		};
+
+		static Product Multiply(std::uint64_t a, std::uint64_t b) noexcept
+		{
+#if defined(__SIZEOF_INT128__)
+			auto product = static_cast<unsigned __int128>(a) * b;
+			return Product{ static_cast<std::uint64_t>(product), static_cast<std::uint64_t>(product >> 64) };
+#elif defined(_MSC_VER) && defined(_M_X64)
+			Product product;
+			product.Low = _umul128(a, b, &product.High);
+			return product;
+#else
+			auto aLow = a & 0xffffffff, aHigh = a >> 32;
+			auto bLow = b & 0xffffffff, bHigh = b >> 32;
+			auto lowLow = aLow * bLow;
+			auto highLow = aHigh * bLow;
+			auto middle = (lowLow >> 32) + (highLow & 0xffffffff) + aLow * bHigh;
+			return Product{ (middle << 32) | (lowLow & 0xffffffff), aHigh * bHigh + (highLow >> 32) + (middle >> 32) };
+#endif
+		}
+
+		static int LeadingZeros(std::uint64_t bits) noexcept
+		{
+			assert(bits);
+#if defined(_MSC_VER) && defined(_M_X64)
+			unsigned long index;
+			_BitScanReverse64(&index, bits);
+			return 63 - static_cast<int>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+			return __builtin_clzll(bits);
+#else
+			auto count = 0;
+			while (!(bits & (std::uint64_t(1) << 63)))
+			{
+				bits <<= 1;
+				count++;
+			}
+			return count;
+#endif
+		}
+
+		static double MakeDouble(std::uint64_t significand, int biasedExponent) noexcept
+		{
+			auto bits = significand | (static_cast<std::uint64_t>(biasedExponent) << 52);
+			double value;
+			std::memcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+
+		// Eisel-Lemire: mantissa * 10^exponent correctly rounded, from the leading 128 bits of the product with 5^exponent.
+		// Returns false on the rare occasions that isn't enough precision to decide the rounding.
+		static bool EiselLemire(std::uint64_t mantissa, int exponent, double& value) noexcept
+		{
+			if (!mantissa || exponent < PowerOf5::Smallest)
+			{
+				value = 0.0;
+				return true;
+			}
+			if (exponent > PowerOf5::Largest)
+			{
+				value = std::numeric_limits<double>::infinity();
+				return true;
+			}
+
+			auto leadingZeros = LeadingZeros(mantissa);
+			mantissa <<= leadingZeros;
+			auto powerOf5 = PowerOf5::For128(exponent);
+			auto product = Multiply(mantissa, powerOf5[0]);
+
+			// We need 55 bits: 53 for the significand, one to detect the leading bit and one to round.
+			// Only when all the bits below those are set could the low half of 5^exponent change the result.
+			constexpr std::uint64_t precisionMask = ~std::uint64_t(0) >> 55;
+			if ((product.High & precisionMask) == precisionMask)
+			{
+				auto lowProduct = Multiply(mantissa, powerOf5[1]);
+				product.Low += lowProduct.High;
+				if (lowProduct.High > product.Low)
+					product.High++;
+				if (product.Low == ~std::uint64_t(0) && (exponent < -27 || exponent > 55))
+					return false;
+			}
+
+			auto upperBit = static_cast<int>(product.High >> 63);
+			auto shift = upperBit + 64 - 52 - 3;
+			auto significand = product.High >> shift;
+			// floor(log2(10^exponent)) + 63 gives the binary exponent of the product's leading bit
+			auto biasedExponent = (((152170 + 65536) * exponent) >> 16) + 63 + upperBit - leadingZeros + 1023;
+
+			if (biasedExponent <= 0)
+			{
+				// Subnormal
+				if (-biasedExponent + 1 >= 64)
+				{
+					value = 0.0;
+					return true;
+				}
+				significand >>= -biasedExponent + 1;
+				significand += significand & 1;
+				significand >>= 1;
+				value = MakeDouble(significand, significand < (std::uint64_t(1) << 52) ? 0 : 1);
+				return true;
+			}
+
+			// Exactly half way between two doubles can only happen for small exponents, and must round to even
+			if (product.Low <= 1 && exponent >= -4 && exponent <= 23 && (significand & 3) == 1 && (significand << shift) == product.High)
+				significand &= ~std::uint64_t(1);
+
+			significand += significand & 1;
+			significand >>= 1;
+			if (significand >= (std::uint64_t(2) << 52))
+			{
+				// Rounding carried into the next power of two
+				significand = std::uint64_t(1) << 52;
+				biasedExponent++;
+			}
+			if (biasedExponent >= 0x7ff)
+			{
+				value = std::numeric_limits<double>::infinity();
+				return true;
+			}
+			value = MakeDouble(significand & ~(std::uint64_t(1) << 52), biasedExponent);
+			return true;
+		}
+
+		// The value of mantissa * 10^exponent, without the sign.
+		// When digits were truncated from the mantissa the true value lies between mantissa and mantissa + 1,
+		// and if those round differently we go back to the text between digits and end.
+		static double ToDouble(std::uint64_t mantissa, int exponent, bool truncated, ParseIterator digits, ParseIterator end)
+		{
+			double value;
+			if (!truncated)
+			{
+				// Clinger's fast path: both the mantissa and the power of ten are exact doubles so one operation rounds correctly
+				if (exponent >= -22 && exponent <= 22 && mantissa <= (std::uint64_t(1) << 53))
+				{
+					value = static_cast<double>(mantissa);
+					if (exponent < 0)
+						return value / PowerOf10<double>::For(static_cast<std::size_t>(-exponent));
+					return value * PowerOf10<double>::For(static_cast<std::size_t>(exponent));
+				}
+				if (EiselLemire(mantissa, exponent, value))
+					return value;
+			}
+			else
+			{
+				double upperValue;
+				if (EiselLemire(mantissa, exponent, value) && EiselLemire(mantissa + 1, exponent, upperValue) && value == upperValue)
+					return value;
+			}
+
+			// Slow but exact
+			auto result = std::from_chars(reinterpret_cast<const char*>(digits), reinterpret_cast<const char*>(end), value);
+			if (result.ec == std::errc::result_out_of_range)
+				value = exponent > 0 ? std::numeric_limits<double>::infinity() : 0.0;
+			return value;
+		}
+
+		// Digits only. The mantissa holds the first 19 digits and exponent counts the digits beyond that.
+		static ParseToken ToInteger(bool negative, std::uint64_t mantissa, int exponent, bool truncated, ParseIterator digits, ParseIterator end)
+		{
+			constexpr auto largestInteger = static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max());
+			if (!exponent)
+			{
+				if (!negative)
+					return mantissa <= largestInteger ? ParseToken(static_cast<std::int64_t>(mantissa)) : ParseToken(mantissa);
+				if (mantissa <= largestInteger + 1)
+					return ParseToken(-static_cast<std::int64_t>(mantissa - 1) - 1);
+				return ParseToken(-static_cast<double>(mantissa));
+			}
+
+			// Twenty digits may still fit an unsigned 64 bit integer
+			if (!negative && exponent == 1)
+			{
+				auto lastDigit = static_cast<std::uint64_t>(end[-1] - '0');
+				if (mantissa <= (std::numeric_limits<std::uint64_t>::max() - lastDigit) / 10)
+					return ParseToken(mantissa * 10 + lastDigit);
+			}
+			auto value = ToDouble(mantissa, exponent, truncated, digits, end);
+			return ParseToken(negative ? -value : value);
+		}
+
 	public:
 		// The first character hasn't matched any of the other easily identified symbols or letters,
 		// so we can only assume it's a number or an unrecognised token.
@@ -43,7 +244,8 @@ namespace August
 			auto iterator = start;
 
 			// Leading minus sign
-			assert(character && character == *iterator);
+			// The character may be the zero terminator when a value is missing, which is reported as unrecognised
+			assert(character == *iterator);
 			auto negative = (character == '-');
 			if (negative)
 			{
@@ -57,7 +259,7 @@ namespace August
 			}
 
 			// ParseNumber digit must follow
-			assert(character && character == *iterator);
+			assert(character == *iterator);
 			if (!IsDigit(character))
 			{
 				if (!negative)
@@ -69,136 +271,177 @@ namespace August
 				throw ParseException(iterator, "ParseNumber expected");
 			}
 
+			// All the significant digits are accumulated in one integer mantissa, up to as many as will fit.
+			// The exponent adjusts for integer digits beyond those and for fraction digits.
+			auto digits = iterator;
+			std::uint64_t mantissa = 0;
+			auto mantissaDigits = 0;
+			auto exponent = 0;
+			auto truncated = false; // Non-zero digits didn't fit in the mantissa
+
 			// Decimal digit sequence starting to form an integer
-			assert(*iterator && character == *iterator);
-			std::int64_t integerValue = 0;
 			if (character != '0')
 			{
 				// Non-zero removes the possibility of single zero or zero prefixed
-				for (;;)
+				do
 				{
-					integerValue = integerValue * 10 + static_cast<std::int64_t>(character) - static_cast<std::int64_t>('0');
-					iterator++;
-					if (!*iterator)
+					if (mantissaDigits < MaximumMantissaDigits)
 					{
-						// Just an integer then EOF
-						start = iterator;
-						return ParseToken(negative ? -integerValue : integerValue);
+						mantissa = mantissa * 10 + static_cast<std::uint64_t>(character - '0');
+						mantissaDigits++;
 					}
-					character = *iterator;
-					if (!IsDigit(character))
+					else
 					{
-						if (character == '.' || IsExponentMarker(character))
-						{
-							// Digits are followed by a dot or exponent
-							// This is the only continuation exiting the for() loop
-							break;
-						}
-						// We've seen an optional minus sign and at least one digit but attached trailing is something else
-						start = iterator;
-						return ParseToken(negative ? -integerValue : integerValue);
+						exponent++;
+						truncated |= character != '0';
 					}
+					character = *++iterator;
+				} while (IsDigit(character));
+
+				if (character != '.' && !IsExponentMarker(character))
+				{
+					// We've seen an optional minus sign and at least one digit but attached trailing is something else (or EOF)
+					start = iterator;
+					return ToInteger(negative, mantissa, exponent, truncated, digits, iterator);
 				}
 			}
 			else
 			{
-				iterator++;
-				if (!*iterator || (!IsDigit(*iterator) && *iterator != '.' && !IsExponentMarker(*iterator)))
-				{
-					// Just a (possibly negative) zero then EOF/non-number
-					start = iterator;
-					return ParseToken(int64_t(0));
-				}
-				character = *iterator;
+				character = *++iterator;
 				if (IsDigit(character))
 				{
 					// Zero followed by anything other than dot or exponent is not allowed
 					throw ParseException(iterator, "Zero prefix not allowed");
 				}
+				if (character != '.' && !IsExponentMarker(character))
+				{
+					// Just a (possibly negative) zero then EOF/non-number
+					start = iterator;
+					return ParseToken(int64_t(0));
+				}
 			}
 
 			// Decimal point followed by a fraction number part
-			assert(character && character == *iterator);
-			int fractionalExponentValue;
-			auto floatingPointValue = static_cast<double>(integerValue);
 			if (character == '.')
 			{
-				iterator++;
-				if (!*iterator || !IsDigit(*iterator))
+				character = *++iterator;
+				if (!IsDigit(character))
 				{
 					// ParseNumber and decimal point followed by EOF or non-digit
 					throw ParseException(iterator, "Expecting number to follow decimal point");
 				}
-				auto fractionalDigitsStart = iterator;
-				character = *iterator;
-				for (;;)
+				do
 				{
-					floatingPointValue = floatingPointValue * 10.0 + static_cast<double>(character) - static_cast<std::int64_t>('0');
-					iterator++;
-					if (!*iterator)
+					if (mantissaDigits < MaximumMantissaDigits)
 					{
-						// Digits past the decimal point and EOF
-						start = iterator;
-						return ParseToken((negative ? -floatingPointValue : floatingPointValue) / PowerOf10<double>::For(static_cast<std::size_t>(iterator - fractionalDigitsStart)));
-					}
-					character = *iterator;
-					if (!IsDigit(character))
-					{
-						if (IsExponentMarker(character))
-						{
-							// The only loop exit to continue to exponent
-							break;
-						}
-						// Decimal number followed by unexpected character
-						start = iterator;
-						return ParseToken((negative ? -floatingPointValue : floatingPointValue) / PowerOf10<double>::For(static_cast<std::size_t>(iterator - fractionalDigitsStart)));
+						// Leading zeros of a fraction aren't significant, so don't use up the mantissa
+						mantissa = mantissa * 10 + static_cast<std::uint64_t>(character - '0');
+						if (mantissa)
+							mantissaDigits++;
+						exponent--;
 					}
+					else
+						truncated |= character != '0';
+					character = *++iterator;
+				} while (IsDigit(character));
+			}
+
+			// Exponent marker followed by optional sign and digits
+			if (IsExponentMarker(character))
+			{
+				character = *++iterator;
+				auto negativeExponent = (character == '-');
+				if (negativeExponent || character == '+')
+					character = *++iterator;
+				if (!IsDigit(character))
+				{
+					// Exponent marker (and sign) followed by EOF or non-digit
+					throw ParseException(iterator, "Expecting number for exponent");
 				}
-				fractionalExponentValue = static_cast<int>(fractionalDigitsStart - iterator);
+				auto exponentValue = 0;
+				do
+				{
+					if (exponentValue < MaximumExponent)
+						exponentValue = exponentValue * 10 + (character - '0');
+					character = *++iterator;
+				} while (IsDigit(character));
+				exponent += negativeExponent ? -exponentValue : exponentValue;
 			}
-			else
-				fractionalExponentValue = 0;
 
-			// Can only be exponent digits
-			assert(*iterator && character == *iterator);
-			iterator++;
-			if (!*iterator || (!IsDigit(*iterator) && *iterator != '-' && *iterator != '+'))
+			start = iterator;
+			auto value = ToDouble(mantissa, exponent, truncated, digits, iterator);
+			return ParseToken(negative ? -value : value);
+		}
+
+		// As Parse() but only validating the number, keeping its text for conversion when it's read
+		static ParseToken ParseText(Character character, ParseIterator& start)
+		{
+			auto iterator = start;
+			assert(character == *iterator);
+			if (character == '-')
 			{
-				// Exponent marker followed by EOF or non-digit
-				throw ParseException(iterator, "Expecting number for exponent");
+				character = *++iterator;
+				if (!character)
+					throw ParseException(iterator, "Numerical digits expected");
+				if (!IsDigit(character))
+					throw ParseException(iterator, "ParseNumber expected");
 			}
-			character = *iterator;
-			auto negativeExponent = (character == '-');
-			if (negativeExponent || character == '+')
+			else if (!IsDigit(character))
+				throw ParseException(start, "Unrecognised token");
+
+			auto form = ParseToken::NumberText::Integer;
+			if (character == '0')
 			{
-				iterator++;
-				if (!*iterator || !IsDigit(*iterator))
-				{
-					// Exponent marker followed by +/- then EOF or non-digit
+				character = *++iterator;
+				if (IsDigit(character))
+					throw ParseException(iterator, "Zero prefix not allowed");
+			}
+			else
+			{
+				do
+					character = *++iterator;
+				while (IsDigit(character));
+			}
+			if (character == '.')
+			{
+				form = ParseToken::NumberText::FloatingPoint;
+				character = *++iterator;
+				if (!IsDigit(character))
+					throw ParseException(iterator, "Expecting number to follow decimal point");
+				do
+					character = *++iterator;
+				while (IsDigit(character));
+			}
+			if (IsExponentMarker(character))
+			{
+				form = ParseToken::NumberText::FloatingPoint;
+				character = *++iterator;
+				if (character == '-' || character == '+')
+					character = *++iterator;
+				if (!IsDigit(character))
 					throw ParseException(iterator, "Expecting number for exponent");
-				}
-				character = *iterator;
+				do
+					character = *++iterator;
+				while (IsDigit(character));
 			}
-			assert(*iterator && character == *iterator && IsDigit(character));
-			int exponentValue = 0;
-			for (;;)
+			auto text = start;
+			start = iterator;
+			// Integers beyond both std::int64_t and std::uint64_t are floating point, just as the regular parse makes them
+			if (form == ParseToken::NumberText::Integer && static_cast<std::size_t>(iterator - text) >= ParseToken::ShortIntegerText)
 			{
-				exponentValue = exponentValue * 10 + (character - '0');
-				iterator++;
-				if (!*iterator || !IsDigit(*iterator))
-				{
-					// Exponent and EOF or unexpected
-					start = iterator;
-					exponentValue = (negativeExponent ? -exponentValue : exponentValue) + fractionalExponentValue;
-					if (exponentValue < 0)
-						floatingPointValue = floatingPointValue / PowerOf10<double>::For(static_cast<std::size_t>(-exponentValue));
-					else
-						floatingPointValue = floatingPointValue * PowerOf10<double>::For(static_cast<std::size_t>(exponentValue));
-					return ParseToken(negative ? -floatingPointValue : floatingPointValue);
-				}
-				character = *iterator;
+				auto at = text;
+				if (Parse(*at, at).IsFloatingPoint())
+					form = ParseToken::NumberText::FloatingPoint;
 			}
+			return ParseToken(form, text, static_cast<std::size_t>(iterator - text));
 		}
 	};
 
+	inline ParseToken ParseNumberText(const Character* text)
+	{
+		// Number parsing only reads, so it's safe to drop the const for the iterator
+		auto iterator = const_cast<ParseIterator>(text);
+		return ParseNumber::Parse(*iterator, iterator);
+	}
+
 }
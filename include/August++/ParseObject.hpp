@@ -1,8 +1,8 @@
 #pragma once
-#include <map>
 #include <cassert>
 #include "Parse.hpp"
 #include "ParseToken.hpp"
+#include "ParseMembers.hpp"
 #include "ParseString.hpp"
 #include "ParseException.hpp"
 
@@ -10,9 +10,10 @@ namespace August
 {
 
 	// Providing parsing of an object
-	// The rest of the time for querying, all functionality is in the base class std::map<StringView, ParseToken>
+	// The rest of the time for querying, all functionality is in the base class ObjectMembers<ParseToken>,
+	// which iterates members in document order
 
-	class ParseObject : public std::map<StringView, ParseToken>
+	class ParseObject : public ObjectMembers<ParseToken>
 	{
 		// We never instance, copy or move
 		void operator=(const ParseObject&) = delete;
@@ -21,14 +22,29 @@ namespace August
 		ParseObject(const ParseObject&) = delete;
 		ParseObject(const ParseObject&&) = delete;
 	public:
+		// The odds of objects having more than a couple of members is greater than none,
+		// so we start off with non-empty to avoid the first resizes once any are added
+		static constexpr std::size_t DefaultSize = 4;
 		// The markers that are used by objects
 		static constexpr Character OpeningBraces = '{';
 		static constexpr Character ClosingBraces = '}';
 		static constexpr Character NameSeparator = ':';
 		static constexpr Character Comma = ',';
 
+		// Storage for a new object, reusing any left in the table by a previous parse to keep its capacity
+		static std::size_t NewObject(ParseContext& context)
+		{
+			auto& objects = context.Objects;
+			auto objectIndex = context.ObjectsUsed++;
+			if (objectIndex == objects.size())
+				objects.emplace_back().reserve(DefaultSize);
+			else
+				objects[objectIndex].clear();
+			return objectIndex;
+		}
+
 		// The first character matches '{', so interpret the rest as an object
-		static ParseToken Parse(ObjectsTable& objects, ArraysTable& arrays, ParseIterator& start)
+		static ParseToken Parse(ParseContext& context, ParseIterator& start)
 		{
 			auto iterator = start;
 			assert(*iterator == OpeningBraces);
@@ -36,8 +52,8 @@ namespace August
 			auto character = SkipWhitespace(iterator);
 
 			// Always reserve new object storage
-			auto objectIndex = objects.size();
-			objects.resize(objectIndex + 1);
+			auto& objects = context.Objects;
+			auto objectIndex = NewObject(context);
 
 			if (character == ClosingBraces)
 				iterator++; // Empty object
@@ -47,13 +63,13 @@ namespace August
 				{
 					if (character != ParseString::Quotes)
 						throw ParseException(iterator, "Expecting opening quotes for a member name");
-					auto name = ParseString::ParseToView(iterator);
+					auto name = ParseString::ParseToView(context, iterator);
 					character = SkipWhitespace(iterator);
 					if (character != NameSeparator)
 						throw ParseException(iterator, "Expecting ':' following object member name");
 					iterator++;
 					character = SkipWhitespace(iterator);
-					auto token = ParseAny(objects, arrays, character, iterator);
+					auto token = ParseAny(context, character, iterator);
 
 					// Note that we don't keep a reference to &objects[objectIndex] for the duration
 					// because ParseAny() may introduce more objects and resize and possibly move
@@ -72,6 +88,7 @@ namespace August
 					character = SkipWhitespace(iterator);
 				}
 			}
+			objects[objectIndex].Complete();
 			start = iterator;
 			return ParseToken(&objects, objectIndex);
 		}
@@ -80,6 +97,12 @@ namespace August
 		{
 			return at(name);
 		}
+
+		// Quicker for names looked up in many objects
+		ParseToken const& operator[](const ParseKey& key) const
+		{
+			return at(key);
+		}
 	};
 
 }
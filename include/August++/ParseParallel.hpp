@@ -0,0 +1,273 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <exception>
+#include <algorithm>
+#include <cstring> // std::memcpy, std::memset, std::strlen
+#include "Parse.hpp"
+#include "ParseSimd.hpp"
+#include "ParseToken.hpp"
+#include "ParseArray.hpp"
+#include "ParseException.hpp"
+
+namespace August
+{
+
+	// The tables of one part of a document parsed in parallel, kept by the document as long as its tokens refer to them
+	struct ParseTables
+	{
+		ObjectsTable Objects;
+		ArraysTable Arrays;
+		NumbersTable Numbers; // Only used with ParseOptions::PackedNumbers
+
+		explicit ParseTables(std::pmr::memory_resource* resource) :
+			Objects(resource),
+			Arrays(resource),
+			Numbers(resource)
+		{
+		}
+	};
+
+	// An optional parallel front end for ParseDocument, for large documents whose root is an array.
+	// A quick first pass follows only the strings and nesting of the document, a block at a time, to find commas
+	// between elements of the root array near evenly spaced offsets. The elements between each of those are then
+	// parsed concurrently, each part into its own tables, and the root array is made from the elements of every part.
+	// Tokens refer to whichever tables they were parsed into, so nothing else needs to be moved to join the parts.
+	// Smaller documents, and those that aren't arrays, are parsed as usual. Errors are those of the regular parse.
+	// The document's memory resource is used by several threads at once, so it needs to be thread safe,
+	// as the default and std::pmr::synchronized_pool_resource are. An instance can be reused between documents.
+
+	class ParseParallel
+	{
+		// We never copy or move, but do reuse
+		void operator=(const ParseParallel&) = delete;
+		void operator=(const ParseParallel&&) = delete;
+		ParseParallel(const ParseParallel&) = delete;
+		ParseParallel(const ParseParallel&&) = delete;
+
+		// The first error in a part, carried as its parts as ParseException can't be copied
+		struct PartError
+		{
+			const Character* Where = nullptr;
+			std::string Message;
+			std::exception_ptr Error;
+		};
+
+		// Parts per thread, so that threads finishing early can take on more
+		static constexpr std::size_t PartsPerThread = 4;
+
+		std::size_t _threads;
+		std::size_t _minimumPart;
+		ParseIterator _opening = nullptr; // The root array's opening bracket
+		std::vector<ParseIterator> _bounds; // The comma or closing bracket that ends each part
+		std::vector<std::vector<ParseToken>> _elements; // Of each part
+		std::vector<PartError> _errors;
+
+		// The first pass, finding where parts end. False when there's only one part, or the nesting doesn't balance.
+		bool Split(ParseIterator document, std::size_t size)
+		{
+			_bounds.clear();
+			auto parts = std::min(_threads * PartsPerThread, size / _minimumPart);
+			auto partSize = size / parts;
+			auto target = partSize; // Where the next part should end, at the first comma after
+			std::size_t depth = 0;
+			std::uint64_t escaped = 0, inStringCarry = 0;
+			auto fullBlocks = size - size % ParseSimd::BlockSize;
+			Character last[ParseSimd::BlockSize];
+			for (std::size_t offset = 0; offset < size; offset += ParseSimd::BlockSize)
+			{
+				const Character* block = document + offset;
+				if (offset == fullBlocks)
+				{
+					// Pad the remainder with whitespace rather than reading past the end of the caller's buffer
+					std::memset(last, ' ', sizeof(last));
+					std::memcpy(last, block, size - fullBlocks);
+					block = last;
+				}
+				auto masks = ParseSimd::ClassifyNesting(block);
+				auto quotes = masks.Quotes & ~ParseSimd::FindEscaped(masks.Backslashes, escaped);
+				auto inString = ParseSimd::PrefixXor(quotes) ^ inStringCarry;
+				inStringCarry = static_cast<std::uint64_t>(static_cast<std::int64_t>(inString) >> 63);
+				auto openings = masks.Openings & ~inString;
+				auto closings = masks.Closings & ~inString;
+
+				// Most blocks only change the depth, as they neither reach the next target nor could close the root
+				if (offset + ParseSimd::BlockSize <= target && ParseSimd::CountBits(closings) < depth)
+				{
+					depth += ParseSimd::CountBits(openings);
+					depth -= ParseSimd::CountBits(closings);
+					continue;
+				}
+
+				auto structurals = openings | closings | (masks.Commas & ~inString);
+				while (structurals)
+				{
+					auto position = ParseSimd::LowestBit(structurals);
+					auto bit = std::uint64_t(1) << position;
+					structurals &= structurals - 1;
+					auto at = offset + position;
+					if (openings & bit)
+					{
+						if (!depth++)
+							_opening = document + at;
+					}
+					else if (closings & bit)
+					{
+						if (!depth)
+							return false;
+						if (!--depth)
+						{
+							_bounds.push_back(document + at);
+							return _bounds.size() > 1;
+						}
+					}
+					else if (depth == 1 && at >= target)
+					{
+						_bounds.push_back(document + at);
+						while (target <= at)
+							target += partSize;
+					}
+				}
+			}
+			return false;
+		}
+
+		// The elements of one part, from just after the comma or bracket before it to the comma or bracket ending it.
+		// The same steps as ParseArray::Parse(), so any error is where the regular parse would find it.
+		void ParsePart(ParseTables& tables, std::size_t part, ParseOptions options)
+		{
+			auto iterator = (part ? _bounds[part - 1] : _opening) + 1;
+			auto end = _bounds[part];
+			ParseContext context{ tables.Objects, tables.Arrays, options };
+			// Packed arrays refer to the numbers table they were packed into, so each part packs into its own
+			if ((options & ParseOptions::PackedNumbers) && !(options & ParseOptions::LazyNumbers))
+			{
+				tables.Numbers.clear();
+				context.Numbers = &tables.Numbers;
+			}
+			auto& elements = _elements[part];
+			elements.clear();
+			auto character = SkipWhitespace(iterator);
+			for (;;)
+			{
+				elements.emplace_back(ParseAny(context, character, iterator));
+				character = SkipWhitespace(iterator);
+				if (iterator == end)
+					return;
+				if (character != ParseArray::CommaSeparator)
+					throw ParseException(iterator, "Expecting comma separating array elements or closing bracket");
+				iterator++;
+				character = SkipWhitespace(iterator);
+			}
+		}
+
+		ParseToken ParseParts(ParseContext& context, std::pmr::deque<ParseTables>& tables, ParseIterator& iterator)
+		{
+			auto parts = _bounds.size();
+			while (tables.size() < parts)
+				tables.emplace_back(context.Objects.get_allocator().resource());
+			_elements.resize(parts);
+			_errors.resize(parts);
+
+			std::atomic<std::size_t> next{ 0 };
+			auto work = [&]
+			{
+				for (auto part = next++; part < parts; part = next++)
+				{
+					auto& error = _errors[part];
+					error.Where = nullptr;
+					error.Error = nullptr;
+					try
+					{
+						ParsePart(tables[part], part, context.Options);
+					}
+					catch (const ParseException& exception)
+					{
+						error.Where = exception.Where;
+						error.Message = exception.what();
+					}
+					catch (...)
+					{
+						error.Error = std::current_exception();
+					}
+				}
+			};
+			{
+				// The calling thread takes parts too
+				std::vector<std::thread> workers;
+				struct Join
+				{
+					std::vector<std::thread>& Workers;
+					~Join()
+					{
+						for (auto& worker : Workers)
+							worker.join();
+					}
+				} join{ workers };
+				for (std::size_t thread = 1; thread < std::min(_threads, parts); thread++)
+					workers.emplace_back(work);
+				work();
+			}
+
+			// Parts before the first error all parsed as they would have in turn, so that error is the regular parse's
+			for (auto& error : _errors)
+			{
+				if (error.Where)
+					throw ParseException(error.Where, error.Message.c_str());
+				if (error.Error)
+					std::rethrow_exception(error.Error);
+			}
+
+			auto index = ParseArray::NewArray(context);
+			auto& root = context.Arrays[index];
+			std::size_t count = 0;
+			for (auto& elements : _elements)
+				count += elements.size();
+			root.reserve(count);
+			for (auto& elements : _elements)
+				root.insert(root.end(), elements.begin(), elements.end());
+
+			iterator = _bounds.back() + 1;
+			if (SkipWhitespace(iterator))
+				throw ParseException(iterator, "Unexpected content after main document");
+			return ParseToken(&context.Arrays, index);
+		}
+
+	public:
+		// Parts smaller than this aren't worth a thread
+		static constexpr std::size_t DefaultMinimumPart = 256 * 1024;
+
+		explicit ParseParallel(std::size_t threads = std::thread::hardware_concurrency(), std::size_t minimumPart = DefaultMinimumPart) :
+			_threads(threads),
+			_minimumPart(std::max<std::size_t>(minimumPart, 1))
+		{
+		}
+
+		std::size_t Threads() const noexcept
+		{
+			return _threads;
+		}
+
+		// Interpret the whole document, populating the tables of the context for the root and those of the parts for the rest.
+		// The iterator is left at the zero terminator.
+		ParseToken Parse(ParseContext& context, std::pmr::deque<ParseTables>& tables, ParseIterator& iterator)
+		{
+			auto size = std::strlen(reinterpret_cast<const char*>(iterator));
+			auto start = iterator;
+			if (_threads > 1 && SkipWhitespace(start) == ParseArray::OpeningBracket && size / _minimumPart > 1 && Split(iterator, size))
+				return ParseParts(context, tables, iterator);
+
+			auto character = SkipWhitespace(iterator);
+			auto root = ParseAny(context, character, iterator);
+			character = SkipWhitespace(iterator);
+			if (character)
+				throw ParseException(iterator, "Unexpected content after main document");
+			return ParseToken(root);
+		}
+	};
+
+}
@@ -0,0 +1,131 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <limits>
+#include "Parse.hpp"
+#include "ParseToken.hpp"
+#include "ParseMembers.hpp"
+#include "ParseObject.hpp"
+#include "ParseArray.hpp"
+#include "ParseException.hpp"
+
+namespace August
+{
+
+	// An RFC 6901 JSON Pointer, such as "/foo/0/a~1b", worked out once into steps for finding values in many documents.
+	// Each step keeps its name unescaped ("~1" as '/' and "~0" as '~') as a ParseKey, so lookups in larger objects
+	// are a hash probe, along with its array index where the name is one ("0", or digits without a leading zero).
+	// The empty pointer refers to the whole document. Names are kept by the pointer, so it can be moved but not copied.
+
+	class JsonPointer
+	{
+		void operator=(const JsonPointer&) = delete;
+		JsonPointer(const JsonPointer&) = delete;
+
+		// Steps whose name isn't an array index, including "-" for the element after the last, never match an element
+		static constexpr std::size_t NoIndex = std::numeric_limits<std::size_t>::max();
+
+		struct Step
+		{
+			ParseKey Key;
+			std::size_t Index;
+		};
+
+		std::unique_ptr<Character[]> _names; // Every step's name, unescaped
+		std::vector<Step> _steps;
+
+		static std::size_t ToIndex(StringView name) noexcept
+		{
+			if (name.empty() || name.size() > std::numeric_limits<std::size_t>::digits10 || (name[0] == '0' && name.size() > 1))
+				return NoIndex;
+			std::size_t index = 0;
+			for (auto character : name)
+			{
+				if (character < '0' || character > '9')
+					return NoIndex;
+				index = index * 10 + (character - '0');
+			}
+			return index;
+		}
+
+	public:
+		static constexpr Character Separator = '/';
+		static constexpr Character Escape = '~';
+
+		// Throws ParseException, pointing into the text, where it isn't a valid pointer
+		explicit JsonPointer(StringView text) :
+			_names(std::make_unique<Character[]>(text.size() + 1))
+		{
+			if (text.empty())
+				return;
+			if (text[0] != Separator)
+				throw ParseException(text.data(), "Expecting '/' at the start of a JSON pointer");
+
+			// Unescape every name first, as keys can only refer to the names once they're all in place
+			std::vector<std::pair<std::size_t, std::size_t>> names; // Offset and length in _names
+			std::size_t length = 0;
+			for (std::size_t position = 1; position <= text.size(); position++)
+			{
+				if (position == text.size() || text[position] == Separator)
+				{
+					auto start = names.empty() ? 0 : names.back().first + names.back().second;
+					names.emplace_back(start, length - start);
+					continue;
+				}
+				auto character = text[position];
+				if (character == Escape)
+				{
+					if (++position == text.size() || (text[position] != '0' && text[position] != '1'))
+						throw ParseException(text.data() + position - 1, "Expecting '~0' or '~1' in a JSON pointer");
+					character = text[position] == '0' ? Escape : Separator;
+				}
+				_names[length++] = character;
+			}
+
+			_steps.reserve(names.size());
+			for (auto& name : names)
+			{
+				StringView view(_names.get() + name.first, name.second);
+				_steps.push_back(Step{ ParseKey(view), ToIndex(view) });
+			}
+		}
+
+		JsonPointer(JsonPointer&&) noexcept = default;
+		JsonPointer& operator=(JsonPointer&&) noexcept = default;
+
+		// Number of reference tokens, zero for the whole document
+		std::size_t size() const noexcept
+		{
+			return _steps.size();
+		}
+
+		// The value referred to within this one, or null where any step finds no member or element, or a value that isn't a container.
+		// Misses are never exceptions, as they may be much of the work where many pointers are tried against each document.
+		const ParseToken* Find(const ParseToken& root) const
+		{
+			auto token = &root;
+			for (auto& step : _steps)
+			{
+				if (token->IsObject())
+				{
+					auto& object = token->As<ParseObject>();
+					auto found = object.find(step.Key);
+					if (found == object.end())
+						return nullptr;
+					token = &found->second;
+				}
+				else if (token->IsArray())
+				{
+					auto& array = token->As<ParseArray>();
+					if (step.Index >= array.size())
+						return nullptr;
+					token = &array[step.Index];
+				}
+				else
+					return nullptr;
+			}
+			return token;
+		}
+	};
+
+}
@@ -0,0 +1,223 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <initializer_list>
+#include "Parse.hpp"
+#include "ParseToken.hpp"
+#include "ParseObject.hpp"
+#include "ParseArray.hpp"
+#include "ParseString.hpp"
+#include "ParseGrammar.hpp"
+#include "ParseCursor.hpp"
+#include "ParseException.hpp"
+
+namespace August
+{
+
+	// An optional front end for ParseDocument that keeps only the values at the given key paths, such as "user.id"
+	// or "entities.hashtags[*].text", where "[*]" is every element of an array. The result is an ordinary document
+	// holding just the requested values and the objects and arrays leading to them. Everything else is stepped over
+	// by matching brackets and quotes, so its strings aren't unescaped and its numbers aren't converted, and it's only
+	// checked as far as its strings and nesting. Member names are matched after unescaping, taking the first of duplicates.
+	// A value that isn't the object or array its path expects holds nothing requested, so its member or element is left out.
+	// Once every requested member of an object has been found the rest of it is stepped over, and once the root object
+	// is complete parsing stops, without looking at anything after.
+	// An instance can be reused between documents.
+
+	class ParseProjection
+	{
+		// We never copy or move, but do reuse
+		void operator=(const ParseProjection&) = delete;
+		void operator=(const ParseProjection&&) = delete;
+		ParseProjection(const ParseProjection&) = delete;
+		ParseProjection(const ParseProjection&&) = delete;
+
+		// A step along the requested paths. Node 0 is the root, so is never a child.
+		struct Node
+		{
+			std::vector<std::pair<Stringified, std::size_t>> Members; // Name and node of each requested member
+			std::size_t Elements = 0; // The node for every element, when there is one
+			bool Whole = false; // A path ends here, so the value is kept in full
+		};
+
+		// Only the first members of an object are tracked for stopping early, which is plenty for paths written by hand
+		static constexpr std::size_t MaximumTracked = 64;
+
+		std::vector<Node> _nodes;
+		bool _stopped = false; // Every requested member of the root object was found
+
+		std::size_t Member(std::size_t node, StringView name)
+		{
+			for (auto& member : _nodes[node].Members)
+				if (member.first == name)
+					return member.second;
+			_nodes[node].Members.emplace_back(Stringified(name), _nodes.size());
+			_nodes.emplace_back();
+			return _nodes.size() - 1;
+		}
+
+		std::size_t Elements(std::size_t node)
+		{
+			if (!_nodes[node].Elements)
+			{
+				_nodes[node].Elements = _nodes.size();
+				_nodes.emplace_back();
+			}
+			return _nodes[node].Elements;
+		}
+
+		// The value at the iterator as far as the node requests, or false where it holds nothing requested and is skipped
+		bool Project(ParseContext& context, const Node& node, Character character, ParseIterator& iterator, ParseToken& token, bool root)
+		{
+			if (node.Whole)
+				token = ParseAny(context, character, iterator);
+			else if (character == ParseObject::OpeningBraces && !node.Members.empty())
+				token = ProjectObject(context, node, iterator, root);
+			else if (character == ParseArray::OpeningBracket && node.Elements)
+				token = ProjectArray(context, _nodes[node.Elements], iterator);
+			else
+			{
+				iterator = Skip(iterator);
+				return false;
+			}
+			return true;
+		}
+
+		// Just the requested members, returning early from the root once all have been found
+		ParseToken ProjectObject(ParseContext& context, const Node& node, ParseIterator& iterator, bool root)
+		{
+			auto& objects = context.Objects;
+			auto objectIndex = ParseObject::NewObject(context);
+			auto tracked = std::min(node.Members.size(), MaximumTracked);
+			auto all = tracked == MaximumTracked ? ~std::uint64_t(0) : (std::uint64_t(1) << tracked) - 1;
+			std::uint64_t found = 0;
+			std::vector<bool> foundUntracked(node.Members.size() - tracked); // Past the first members, only for skipping duplicates
+
+			auto names = [&context](ParseIterator& at)
+			{
+				return ParseString::ParseToView(context, at);
+			};
+			ParseGrammar::Object(iterator, names, [&](StringView name, Character next, ParseIterator& at)
+			{
+				std::size_t position = 0;
+				while (position < node.Members.size() && node.Members[position].first != name)
+					position++;
+				if (position == node.Members.size() || (position < tracked ? (found >> position) & 1 : foundUntracked[position - tracked]))
+				{
+					at = Skip(at);
+					return true;
+				}
+
+				ParseToken token;
+				if (Project(context, _nodes[node.Members[position].second], next, at, token, false))
+					objects[objectIndex].emplace(name, token);
+				if (position < tracked)
+					found |= std::uint64_t(1) << position;
+				else
+					foundUntracked[position - tracked] = true;
+				if (found != all || tracked != node.Members.size())
+					return true;
+				if (root)
+					_stopped = true;
+				else
+					at = ValueCursor::Iterator(ValueCursor::SkipContainer(at, 1));
+				return false;
+			});
+			objects[objectIndex].Complete();
+			return ParseToken(&objects, objectIndex);
+		}
+
+		// The requested part of every element
+		ParseToken ProjectArray(ParseContext& context, const Node& node, ParseIterator& iterator)
+		{
+			auto& arrays = context.Arrays;
+			auto arrayIndex = ParseArray::NewArray(context);
+			ParseGrammar::Array(iterator, [&](Character next, ParseIterator& at)
+			{
+				ParseToken token;
+				if (Project(context, node, next, at, token, false))
+					arrays[arrayIndex].emplace_back(token);
+			});
+			return ParseToken(&arrays, arrayIndex);
+		}
+
+	public:
+		static constexpr Character Separator = '.';
+		static constexpr Character OpeningBracket = '[';
+		static constexpr Character Wildcard = '*';
+		static constexpr Character ClosingBracket = ']';
+
+		// Where the value starting at the iterator ends, checking only its strings and nesting, for a value that isn't wanted
+		static ParseIterator Skip(ParseIterator iterator)
+		{
+			return ValueCursor::Iterator(ValueCursor::Skip(iterator));
+		}
+
+		ParseProjection() :
+			_nodes(1)
+		{
+		}
+
+		ParseProjection(std::initializer_list<StringView> paths) :
+			_nodes(1)
+		{
+			for (auto path : paths)
+				Add(path);
+		}
+
+		// Request another path. Throws ParseException, pointing into the path, where it isn't one.
+		// Names are separated by '.', so can't themselves contain '.' or '['.
+		void Add(StringView path)
+		{
+			std::size_t node = 0;
+			std::size_t position = 0;
+			for (;;)
+			{
+				if (position < path.size() && path[position] == OpeningBracket)
+				{
+					if (position + 2 >= path.size() || path[position + 1] != Wildcard || path[position + 2] != ClosingBracket)
+						throw ParseException(path.data() + position, "Expecting '[*]' in a key path");
+					node = Elements(node);
+					position += 3;
+				}
+				else
+				{
+					auto end = position;
+					while (end < path.size() && path[end] != Separator && path[end] != OpeningBracket)
+						end++;
+					if (end == position)
+						throw ParseException(path.data() + position, "Expecting a member name in a key path");
+					node = Member(node, path.substr(position, end - position));
+					position = end;
+				}
+				if (position == path.size())
+					break;
+				if (path[position] != Separator && path[position] != OpeningBracket)
+					throw ParseException(path.data() + position, "Expecting '.' or '[' after '[*]' in a key path");
+				if (path[position] == Separator && ++position == path.size())
+					throw ParseException(path.data() + position - 1, "Expecting a member name in a key path");
+			}
+			_nodes[node].Whole = true;
+		}
+
+		// Interpret the requested parts of the document, populating the tables of the context.
+		// Other than when stopping early, the iterator is left at the zero terminator.
+		ParseToken Parse(ParseContext& context, ParseIterator& iterator)
+		{
+			auto character = SkipWhitespace(iterator);
+			if (!character)
+				throw ParseException(iterator, "Expecting a value");
+			ParseToken root;
+			_stopped = false;
+			Project(context, _nodes.front(), character, iterator, root, true);
+			if (_stopped)
+				return ParseToken(root);
+			character = SkipWhitespace(iterator);
+			if (character)
+				throw ParseException(iterator, "Unexpected content after main document");
+			return ParseToken(root);
+		}
+	};
+
+}
@@ -0,0 +1,336 @@
+#pragma once
+#include <cstdint>
+#include "StringType.hpp"
+
+// Pick the widest instruction set the compiler has been told it can use.
+// Define AUGUST_NO_SIMD before including to force the portable scalar code paths.
+#if !defined(AUGUST_NO_SIMD)
+#if defined(__AVX2__)
+#define AUGUST_SIMD_AVX2 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AUGUST_SIMD_SSE2 1
+#endif
+#endif
+
+#if defined(AUGUST_SIMD_AVX2)
+#include <immintrin.h>
+#elif defined(AUGUST_SIMD_SSE2)
+#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Kernels that read whole aligned vectors may read past the zero terminator, though never past the page it's in.
+// That's harmless, but address and thread sanitizers rightly can't tell, as the bytes past the end may belong to
+// a freed or concurrently written allocation, so those kernels opt out of both.
+#if defined(__clang__)
+#define AUGUST_NO_SANITIZE __attribute__((no_sanitize("address", "thread")))
+#elif defined(__GNUC__)
+#define AUGUST_NO_SANITIZE __attribute__((no_sanitize_address, no_sanitize_thread))
+#elif defined(_MSC_VER)
+#define AUGUST_NO_SANITIZE __declspec(no_sanitize_address)
+#else
+#define AUGUST_NO_SANITIZE
+#endif
+
+namespace August
+{
+
+	// Low level helpers for scanning the document many bytes at a time.
+	// Every routine here has a scalar equivalent so that non-x86 targets behave identically.
+
+	class ParseSimd
+	{
+		// We never instance, copy or move
+		void operator=(const ParseSimd&) = delete;
+		void operator=(const ParseSimd&&) = delete;
+		ParseSimd() = delete;
+		ParseSimd(const ParseSimd&) = delete;
+		ParseSimd(const ParseSimd&&) = delete;
+
+#if defined(AUGUST_SIMD_AVX2)
+		// Bit n set for byte n of the 32 that matches the marker
+		static std::uint64_t Matches(__m256i bytes, char marker) noexcept
+		{
+			return static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(marker)))));
+		}
+
+		using Vector = __m256i;
+		static constexpr std::size_t VectorSize = 32;
+		AUGUST_NO_SANITIZE static Vector LoadAligned(const Character* at) noexcept
+		{
+			return _mm256_load_si256(reinterpret_cast<const __m256i*>(at));
+		}
+
+		// Bit n set for byte n that is a quote, backslash or control character (including the zero terminator)
+		static std::uint32_t StringSpecials(Vector bytes) noexcept
+		{
+			auto control = _mm256_cmpeq_epi8(_mm256_min_epu8(bytes, _mm256_set1_epi8(0x1f)), bytes);
+			auto quote = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('"'));
+			auto backslash = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\\'));
+			return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(control, _mm256_or_si256(quote, backslash))));
+		}
+
+		// Bit n set for byte n that isn't whitespace (including the zero terminator)
+		static std::uint32_t NonWhitespace(Vector bytes) noexcept
+		{
+			auto space = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(' '));
+			auto tab = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\t'));
+			auto lineFeed = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\n'));
+			auto carriageReturn = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\r'));
+			return ~static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(space, tab), _mm256_or_si256(lineFeed, carriageReturn))));
+		}
+#elif defined(AUGUST_SIMD_SSE2)
+		// Bit n set for byte n of the 16 that matches the marker
+		static std::uint64_t Matches(__m128i bytes, char marker) noexcept
+		{
+			return static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(marker)))));
+		}
+
+		using Vector = __m128i;
+		static constexpr std::size_t VectorSize = 16;
+		AUGUST_NO_SANITIZE static Vector LoadAligned(const Character* at) noexcept
+		{
+			return _mm_load_si128(reinterpret_cast<const __m128i*>(at));
+		}
+
+		// Bit n set for byte n that is a quote, backslash or control character (including the zero terminator)
+		static std::uint32_t StringSpecials(Vector bytes) noexcept
+		{
+			auto control = _mm_cmpeq_epi8(_mm_min_epu8(bytes, _mm_set1_epi8(0x1f)), bytes);
+			auto quote = _mm_cmpeq_epi8(bytes, _mm_set1_epi8('"'));
+			auto backslash = _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\\'));
+			return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_or_si128(control, _mm_or_si128(quote, backslash))));
+		}
+
+		// Bit n set for byte n that isn't whitespace (including the zero terminator)
+		static std::uint32_t NonWhitespace(Vector bytes) noexcept
+		{
+			auto space = _mm_cmpeq_epi8(bytes, _mm_set1_epi8(' '));
+			auto tab = _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\t'));
+			auto lineFeed = _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n'));
+			auto carriageReturn = _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\r'));
+			return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(space, tab), _mm_or_si128(lineFeed, carriageReturn)))) ^ 0xffffu;
+		}
+#endif
+
+		static constexpr bool IsWhitespace(Character byte) noexcept
+		{
+			return byte == 0x9 || byte == 0xA || byte == 0xD || byte == 0x20;
+		}
+
+		static constexpr bool IsStringSpecial(Character byte) noexcept
+		{
+			return byte == '"' || byte == '\\' || static_cast<unsigned char>(byte) < 0x20;
+		}
+
+	public:
+		// The number of bytes classified at once by ClassifyNesting()
+		static constexpr std::size_t BlockSize = 64;
+
+		// One bit per byte of a 64 byte block, for following the nesting of containers without the rest of the structure
+		struct NestingMasks
+		{
+			std::uint64_t Quotes;
+			std::uint64_t Backslashes;
+			std::uint64_t Openings; // {[
+			std::uint64_t Closings; // }]
+			std::uint64_t Commas;
+		};
+
+		static NestingMasks ClassifyNesting(const Character* block) noexcept
+		{
+			NestingMasks masks;
+			masks.Quotes = masks.Backslashes = masks.Openings = masks.Closings = masks.Commas = 0;
+#if defined(AUGUST_SIMD_AVX2) || defined(AUGUST_SIMD_SSE2)
+#if defined(AUGUST_SIMD_AVX2)
+			constexpr auto width = 32;
+			auto caseFold = _mm256_set1_epi8(0x20);
+#else
+			constexpr auto width = 16;
+			auto caseFold = _mm_set1_epi8(0x20);
+#endif
+			for (auto shift = 0; shift < static_cast<int>(BlockSize); shift += width)
+			{
+#if defined(AUGUST_SIMD_AVX2)
+				auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + shift));
+				auto folded = _mm256_or_si256(bytes, caseFold);
+#else
+				auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + shift));
+				auto folded = _mm_or_si128(bytes, caseFold);
+#endif
+				masks.Quotes |= Matches(bytes, '"') << shift;
+				masks.Backslashes |= Matches(bytes, '\\') << shift;
+				masks.Openings |= Matches(folded, '{') << shift;
+				masks.Closings |= Matches(folded, '}') << shift;
+				masks.Commas |= Matches(bytes, ',') << shift;
+			}
+#else
+			for (std::size_t i = 0; i < BlockSize; i++)
+			{
+				auto bit = std::uint64_t(1) << i;
+				switch (block[i])
+				{
+				case '"': masks.Quotes |= bit; break;
+				case '\\': masks.Backslashes |= bit; break;
+				case '{': case '[': masks.Openings |= bit; break;
+				case '}': case ']': masks.Closings |= bit; break;
+				case ',': masks.Commas |= bit; break;
+				}
+			}
+#endif
+			return masks;
+		}
+
+		// Bit n set when byte n of a block follows a backslash that isn't itself escaped.
+		// Backslashes are rare enough that walking them one at a time beats a branchless approach.
+		static std::uint64_t FindEscaped(std::uint64_t backslashes, std::uint64_t& carry) noexcept
+		{
+			auto escaped = carry;
+			backslashes &= ~carry;
+			carry = 0;
+			while (backslashes)
+			{
+				auto backslash = backslashes & (0 - backslashes);
+				auto following = backslash << 1;
+				if (!following)
+					carry = 1; // Last byte of the block escapes the first byte of the next
+				escaped |= following;
+				backslashes &= ~(backslash | following);
+			}
+			return escaped;
+		}
+
+		// Each bit becomes the xor of itself and every bit below it,
+		// turning the positions of quotes into spans covering the strings between them
+		static constexpr std::uint64_t PrefixXor(std::uint64_t bits) noexcept
+		{
+			bits ^= bits << 1;
+			bits ^= bits << 2;
+			bits ^= bits << 4;
+			bits ^= bits << 8;
+			bits ^= bits << 16;
+			bits ^= bits << 32;
+			return bits;
+		}
+
+		// The first quote, backslash or control character (including the zero terminator) at or after the given position.
+		// Bytes are stepped through individually until the position is aligned, then checked a whole vector at a time.
+		template<class Iterator_>
+		AUGUST_NO_SANITIZE static Iterator_ FindStringSpecial(Iterator_ at) noexcept
+		{
+#if defined(AUGUST_SIMD_AVX2) || defined(AUGUST_SIMD_SSE2)
+			while (reinterpret_cast<std::uintptr_t>(at) & (VectorSize - 1))
+			{
+				if (IsStringSpecial(*at))
+					return at;
+				at++;
+			}
+			for (;;)
+			{
+				auto specials = StringSpecials(LoadAligned(at));
+				if (specials)
+					return at + LowestBit(specials);
+				at += VectorSize;
+			}
+#else
+			while (!IsStringSpecial(*at))
+				at++;
+			return at;
+#endif
+		}
+
+		// The first non-whitespace byte (including the zero terminator) at or after the given position.
+		// Intended for long runs such as indentation; short gaps are better handled before calling.
+		template<class Iterator_>
+		AUGUST_NO_SANITIZE static Iterator_ FindNonWhitespace(Iterator_ at) noexcept
+		{
+#if defined(AUGUST_SIMD_AVX2) || defined(AUGUST_SIMD_SSE2)
+			while (reinterpret_cast<std::uintptr_t>(at) & (VectorSize - 1))
+			{
+				if (!IsWhitespace(*at))
+					return at;
+				at++;
+			}
+			for (;;)
+			{
+				auto nonWhitespace = NonWhitespace(LoadAligned(at));
+				if (nonWhitespace)
+					return at + LowestBit(nonWhitespace);
+				at += VectorSize;
+			}
+#else
+			while (IsWhitespace(*at))
+				at++;
+			return at;
+#endif
+		}
+
+		// The first line feed at or after the given position, or the end when there's none before it.
+		// Unlike the other searches this is bounded, as the buffer holds many documents and isn't yet terminated.
+		template<class Iterator_>
+		AUGUST_NO_SANITIZE static Iterator_ FindLineFeed(Iterator_ at, Iterator_ end) noexcept
+		{
+#if defined(AUGUST_SIMD_AVX2) || defined(AUGUST_SIMD_SSE2)
+			while (at != end && (reinterpret_cast<std::uintptr_t>(at) & (VectorSize - 1)))
+			{
+				if (*at == '\n')
+					return at;
+				at++;
+			}
+			while (at < end)
+			{
+				auto lineFeeds = Matches(LoadAligned(at), '\n');
+				if (lineFeeds)
+				{
+					auto found = at + LowestBit(lineFeeds);
+					return found < end ? found : end;
+				}
+				at += VectorSize;
+			}
+			return end;
+#else
+			while (at != end && *at != '\n')
+				at++;
+			return at;
+#endif
+		}
+
+		static inline unsigned CountBits(std::uint64_t bits) noexcept
+		{
+#if defined(_MSC_VER) && defined(_M_X64)
+			return static_cast<unsigned>(__popcnt64(bits));
+#elif defined(__GNUC__) || defined(__clang__)
+			return static_cast<unsigned>(__builtin_popcountll(bits));
+#else
+			unsigned count = 0;
+			for (; bits; bits &= bits - 1)
+				count++;
+			return count;
+#endif
+		}
+
+		// Index of the lowest set bit. Bits must be non-zero.
+		static inline unsigned LowestBit(std::uint64_t bits) noexcept
+		{
+#if defined(_MSC_VER) && defined(_M_X64)
+			unsigned long index;
+			_BitScanForward64(&index, bits);
+			return static_cast<unsigned>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+			return static_cast<unsigned>(__builtin_ctzll(bits));
+#else
+			unsigned index = 0;
+			while (!(bits & 1))
+			{
+				bits >>= 1;
+				index++;
+			}
+			return index;
+#endif
+		}
+	};
+
+}
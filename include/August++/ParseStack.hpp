@@ -0,0 +1,154 @@
+#pragma once
+#include <vector>
+#include <cassert>
+#include "Parse.hpp"
+#include "ParseToken.hpp"
+#include "ParseObject.hpp"
+#include "ParseArray.hpp"
+#include "ParseString.hpp"
+#include "ParseGrammar.hpp"
+#include "ParseException.hpp"
+
+namespace August
+{
+
+	// An optional non-recursive front end for ParseDocument.
+	// The regular parse recurses once per level of nesting, so deeply nested input can exhaust the call stack.
+	// Here the open objects and arrays are kept on an explicit stack instead, which is limited to a maximum depth
+	// beyond which the document is rejected with a ParseException. The tables built, and any errors, are otherwise
+	// identical to the regular parse. An instance can be reused between documents to keep the capacity of the stack.
+	// This is for safety rather than speed: it isn't faster than recursion, and is typically a few percent slower.
+
+	class ParseStack
+	{
+		// We never copy or move, but do reuse
+		void operator=(const ParseStack&) = delete;
+		void operator=(const ParseStack&&) = delete;
+		ParseStack(const ParseStack&) = delete;
+		ParseStack(const ParseStack&&) = delete;
+
+		// An object or array that's still open
+		struct Frame
+		{
+			std::size_t Index; // Within the objects or arrays table
+			bool IsObject;
+		};
+		std::vector<Frame> _frames;
+		std::size_t _maxDepth;
+
+	public:
+		// Enough for any reasonable document, whilst far short of what would exhaust a thread's stack when recursing
+		static constexpr std::size_t DefaultMaxDepth = 1024;
+
+		explicit ParseStack(std::size_t maxDepth = DefaultMaxDepth) :
+			_maxDepth(maxDepth)
+		{
+		}
+
+		std::size_t MaxDepth() const noexcept
+		{
+			return _maxDepth;
+		}
+
+		// Interpret the whole document and populate the tables.
+		// The iterator is left at the zero terminator.
+		ParseToken Parse(ParseContext& context, ParseIterator& iterator)
+		{
+			// The innermost open container is kept in locals, with only those enclosing it on the stack
+			_frames.clear();
+			Frame current{ 0, false };
+			std::size_t depth = 0;
+			ParseToken root;
+			StringView name; // Of the object member whose value comes next
+			auto names = [&context](ParseIterator& at)
+			{
+				return ParseString::ParseToView(context, at);
+			};
+			auto character = SkipWhitespace(iterator);
+			for (;;)
+			{
+				// A value starts at the current character.
+				// Containers are added to their parent as soon as they're opened, as the token only refers to their index
+				ParseToken token;
+				auto isObject = character == ParseObject::OpeningBraces;
+				auto isContainer = isObject || character == ParseArray::OpeningBracket;
+				std::size_t index = 0;
+				if (isObject)
+				{
+					index = ParseObject::NewObject(context);
+					token = ParseToken(&context.Objects, index);
+				}
+				else if (isContainer)
+				{
+					index = ParseArray::NewArray(context);
+					token = ParseToken(&context.Arrays, index);
+				}
+				else
+					token = ParseAny(context, character, iterator);
+
+				if (!depth)
+					root = token;
+				else if (current.IsObject)
+					context.Objects[current.Index].emplace(name, token);
+				else
+					context.Arrays[current.Index].emplace_back(token);
+
+				if (isContainer)
+				{
+					if (depth == _maxDepth)
+						throw ParseException(iterator, "Exceeded maximum nesting depth");
+					if (depth++)
+						_frames.push_back(current);
+					current = Frame{ index, isObject };
+					iterator++;
+					character = SkipWhitespace(iterator);
+					if (character != (isObject ? ParseObject::ClosingBraces : ParseArray::ClosingBracket))
+					{
+						// Straight on to the first member or element
+						if (isObject)
+							character = ParseGrammar::MemberName(iterator, character, names, name);
+						continue;
+					}
+					// Empty, so closed below
+				}
+				else
+					character = SkipWhitespace(iterator);
+
+				// Following a value, close containers until there's a comma to continue from
+				for (;;)
+				{
+					if (!depth)
+					{
+						if (character)
+							throw ParseException(iterator, "Unexpected content after main document");
+						return ParseToken(root);
+					}
+					if (current.IsObject)
+					{
+						if (ParseGrammar::MoreMembers(character, iterator))
+						{
+							iterator++;
+							character = ParseGrammar::MemberName(iterator, SkipWhitespace(iterator), names, name);
+							break;
+						}
+						context.Objects[current.Index].Complete();
+					}
+					else if (ParseGrammar::MoreElements(character, iterator))
+					{
+						iterator++;
+						character = SkipWhitespace(iterator);
+						break;
+					}
+					iterator++;
+					if (--depth)
+					{
+						current = _frames.back();
+						_frames.pop_back();
+					}
+					character = SkipWhitespace(iterator);
+				}
+			}
+		}
+	};
+
+}
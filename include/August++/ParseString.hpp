@@ -3,6 +3,7 @@
 #include <cassert>
 #include <algorithm>
 #include "Parse.hpp"
+#include "ParseSimd.hpp"
 #include "ParseToken.hpp"
 #include "ParseException.hpp"
 
@@ -24,6 +25,8 @@ namespace August
 			ParseIterator test = at;
 			for (;;)
 			{
+				// Skip ahead to the next byte that needs a closer look, several at a time where possible
+				test = ParseSimd::FindStringSpecial(test);
 				switch (*test)
 				{
 				case 0:
@@ -53,7 +56,7 @@ namespace August
 				return static_cast<std::uint16_t>(c - '0');
 			c |= 0x20;
 			if (c >= 'a' && c <= 'f')
-				return static_cast<std::uint16_t>(c - 'a' + 0x10);
+				return static_cast<std::uint16_t>(c - 'a' + 10);
 			throw ParseException(at, "Bad hex digit");
 		}
 
@@ -61,7 +64,7 @@ namespace August
 		{
 			if (!(code & ~std::uint16_t(0x7f))) // 7 bits
 				*at++ = static_cast<Character>(code & 0x7f);
-			if (!(code & ~std::uint16_t(0x7ff))) // 11 bits
+			else if (!(code & ~std::uint16_t(0x7ff))) // 11 bits
 			{
 				*at++ = static_cast<Character>(((code & 0x7c0) >> 6) | 0xc0);
 				*at++ = static_cast<Character>((code & 0x03f) | 0x80);
@@ -75,6 +78,77 @@ namespace August
 			return at;
 		}
 
+		// Interpret the escape sequence starting with the backslash at the iterator, leaving the iterator following it.
+		// The decoded bytes are written to the output, which may trail the iterator within the same buffer as it's never longer.
+		static void Unescape(ParseIterator& iterator, ParseIterator& output)
+		{
+			assert(*iterator == '\\');
+			iterator++;
+			if (!*iterator)
+				throw ParseException(iterator, "EOF during escape sequence");
+			auto adjustedCode = *iterator;
+			switch (adjustedCode)
+			{
+			case '"':
+			case '\\':
+			case '/':
+				// %x22 /          ; "    quotation mark  U+0022
+				// %x5C /          ; \    reverse solidus U+005C
+				// %x2F /          ; /    solidus         U+002F
+				break;
+
+			case 'b':
+				// %x62 /          ; b    backspace       U+0008
+				adjustedCode = 0x8;
+				break;
+
+			case 'f':
+				// %x66 /          ; f    form feed       U+000C
+				adjustedCode = 0xc;
+				break;
+
+			case 'n':
+				// %x6E /          ; n    line feed       U+000A
+				adjustedCode = 0xa;
+				break;
+
+			case 'r':
+				// %x72 /          ; r    carriage return U+000D
+				adjustedCode = 0xd;
+				break;
+
+			case 't':
+				// %x74 /          ; t    tab             U+0009
+				adjustedCode = 0x9;
+				break;
+
+			case 'u':
+				// %x75 4HEXDIG )  ; uXXXX                U+XXXX
+			{
+				// Because ascii "/uXXXX" is always more bytes (6) than the equivalent utf-8 (max. 3 bytes),
+				// we can in-place encode and overwrite, at the penalty of shuffling following characters in blocks.
+				auto shift = 16u;
+				std::uint16_t code = 0;
+				do
+				{
+					iterator++;
+					if (!*iterator)
+						throw ParseException(iterator, "Bad escape");
+					shift -= 4;
+					code |= HexDigit(iterator) << shift;
+				} while (shift);
+				iterator++;
+				output = WriteUtf8(output, code);
+			}
+			return;
+
+			default:
+				throw ParseException(iterator, "Unrecognised escape sequence");
+			}
+			*output++ = adjustedCode;
+			iterator++;
+		}
+
 	public:
 		constexpr ParseString(const ParseString& rhs) noexcept : StringView(rhs)
 		{
@@ -122,72 +196,108 @@ namespace August
 					start = iterator;
 					return StringView(reinterpret_cast<StringView::const_pointer>(beginning), static_cast<std::size_t>(translatedEnd - beginning));
 				}
-				iterator++;
-				if (!*iterator)
-					throw ParseException(iterator, "EOF during escape sequence");
-				auto adjustedCode = *iterator;
-				switch (adjustedCode)
-				{
-				case '"':
-				case '\\':
-				case '/':
-					// %x22 /          ; "    quotation mark  U+0022
-					// %x5C /          ; \    reverse solidus U+005C
-					// %x2F /          ; /    solidus         U+002F
-					break;
-
-				case 'b':
-					// %x62 /          ; b    backspace       U+0008
-					adjustedCode = 0x8;
-					break;
-
-				case 'f':
-					// %x66 /          ; f    form feed       U+000C
-					adjustedCode = 0xc;
-					break;
-
-				case 'n':
-					// %x6E /          ; n    line feed       U+000A
-					adjustedCode = 0xa;
-					break;
-
-				case 'r':
-					// %x72 /          ; r    carriage return U+000D
-					adjustedCode = 0xd;
-					break;
-
-				case 't':
-					// %x74 /          ; t    tab             U+0009
-					adjustedCode = 0x9;
-					break;
-
-				case 'u':
-					// %x75 4HEXDIG )  ; uXXXX                U+XXXX
-				{
-					// Because ascii "/uXXXX" is always more bytes (6) than the equivalent utf-8 (max. 3 bytes),
-					// we can in-place encode and overwrite, at the penalty of shuffling following characters in blocks.
-					auto shift = 16u;
-					std::uint16_t code = 0;
-					do
-					{
-						iterator++;
-						if (!*iterator)
-							throw ParseException(iterator, "Bad escape");
-						shift -= 4;
-						code |= HexDigit(iterator) << shift;
-					} while (shift);
-					iterator++;
-					translatedEnd = WriteUtf8(translatedEnd, code);
-				}
-				continue;
+				Unescape(iterator, translatedEnd);
+			}
+		}
 
-				default:
-					throw ParseException(iterator, "Unrecognised escape sequence");
-				}
-				*translatedEnd++ = adjustedCode;
-				iterator++;
+		// As ParseToView() but never writing to the document, for read only buffers.
+		// Escape sequences are checked but left in place, and the result says whether there were any.
+		static StringView ScanToView(ParseIterator& start, bool& escaped)
+		{
+			assert(*start == Quotes);
+			start++;
+			auto iterator = start;
+			escaped = false;
+			while (FindNextEscape(iterator))
+			{
+				escaped = true;
+				Character scratch[3];
+				ParseIterator output = scratch;
+				Unescape(iterator, output);
+			}
+			auto beginning = start;
+			start = iterator + 1;
+			return StringView(reinterpret_cast<StringView::const_pointer>(beginning), static_cast<std::size_t>(iterator - beginning));
+		}
+
+		// Parsing within a document, which may be read only
+		static ParseToken Parse(ParseContext& context, ParseIterator& start)
+		{
+			if (!context.Escapes)
+				return Parse(start);
+			bool escaped;
+			auto stringView = ScanToView(start, escaped);
+			if (!escaped)
+				return ParseToken(stringView.data(), stringView.size());
+			auto& strings = *context.Escapes;
+			return ParseToken(&strings.Strings.emplace_back(EscapedString{ stringView.data(), stringView.size(), &strings.Decoded }));
+		}
+
+		// Member names are needed for lookup straight away, so any escapes are decoded immediately
+		static StringView ParseToView(ParseContext& context, ParseIterator& start)
+		{
+			if (!context.Escapes)
+				return ParseToView(start);
+			bool escaped;
+			auto stringView = ScanToView(start, escaped);
+			if (!escaped)
+				return stringView;
+			auto& strings = *context.Escapes;
+			return ParseEscapedText(strings.Strings.emplace_back(EscapedString{ stringView.data(), stringView.size(), &strings.Decoded }));
+		}
+
+		// Decode text checked by ScanToView() to the output, which needs to be as long as the text. Returns the end of the output.
+		static Character* Decode(const Character* text, std::size_t length, Character* output)
+		{
+			// Decoding only reads from the text, so it's safe to drop the const for the iterator
+			auto iterator = const_cast<ParseIterator>(text);
+			auto end = iterator + length;
+			for (;;)
+			{
+				auto backslash = std::find(iterator, end, '\\');
+				output = std::copy(iterator, backslash, output);
+				if (backslash == end)
+					return output;
+				iterator = backslash;
+				Unescape(iterator, output);
+			}
+		}
+
+		// Whether text checked by ScanToView() decodes to the name, decoding an escape at a time so nothing is kept
+		static bool DecodesTo(const Character* text, std::size_t length, StringView name)
+		{
+			auto iterator = const_cast<ParseIterator>(text);
+			auto end = iterator + length;
+			auto expected = name.begin();
+			for (;;)
+			{
+				auto backslash = std::find(iterator, end, '\\');
+				auto plain = static_cast<std::size_t>(backslash - iterator);
+				if (static_cast<std::size_t>(name.end() - expected) < plain || !std::equal(iterator, backslash, expected))
+					return false;
+				expected += plain;
+				if (backslash == end)
+					return expected == name.end();
+				iterator = backslash;
+				Character scratch[3];
+				ParseIterator output = scratch;
+				Unescape(iterator, output);
+				for (auto decoded = scratch; decoded != output; decoded++)
+					if (expected == name.end() || *expected++ != *decoded)
+						return false;
 			}
 		}
 	};
 
+	inline StringView ParseEscapedText(const EscapedString& escaped)
+	{
+		if (!escaped.DecodedText)
+		{
+			auto decoded = static_cast<Character*>(escaped.Storage->allocate(escaped.Length, 1));
+			escaped.DecodedLength = static_cast<std::size_t>(ParseString::Decode(escaped.Text, escaped.Length, decoded) - decoded);
+			escaped.DecodedText = decoded;
+		}
+		return StringView(reinterpret_cast<StringView::const_pointer>(escaped.DecodedText), escaped.DecodedLength);
+	}
+
 }
@@ -0,0 +1,379 @@
+#pragma once
+#include <vector>
+#include <utility> // std::pair<>
+#include <iterator>
+#include <stdexcept> // std::out_of_range
+#include <type_traits>
+#include "Parse.hpp"
+#include "ParseToken.hpp"
+#include "ParseObject.hpp"
+#include "ParseArray.hpp"
+#include "ParseString.hpp"
+#include "ParseBoolean.hpp"
+#include "ParseNull.hpp"
+#include "ParseNumber.hpp"
+#include "ParseGrammar.hpp"
+#include "ParseException.hpp"
+
+namespace August
+{
+
+	// An alternative to ParseDocument storing the whole document as one flat run of tokens in document order.
+	// Objects and arrays are a header token holding their member or element count and how many tokens the
+	// container spans, so a container can be stepped over without visiting its contents.
+	// Object members are stored as a string token for the name followed by the value.
+	// There is a single allocation for the whole document rather than one per object and array,
+	// at the cost of lookups by name, and by index in arrays holding containers, being linear rather than through a
+	// map or vector. Iterate to visit every member or element.
+
+	class TapeObject;
+	class TapeArray;
+
+	// A read only view of one value of a TapeDocument, offering the same queries as ParseToken
+
+	class TapeValue
+	{
+		friend class TapeObject;
+		friend class TapeArray;
+
+		// The number of tokens spanned by the value starting at the given token
+		static std::size_t Skip(const ParseToken* token) noexcept
+		{
+			auto type = token->GetType();
+			if (type == ParseToken::TokenType::TapeObject || type == ParseToken::TokenType::TapeArray)
+				return static_cast<std::size_t>(token->_data._unsignedInteger);
+			return 1;
+		}
+		static std::size_t Count(const ParseToken* token) noexcept
+		{
+			return token->GetIndex();
+		}
+	protected:
+		const ParseToken* _token;
+	public:
+		explicit constexpr TapeValue(const ParseToken* token) noexcept : _token(token) {}
+
+		bool IsNull() const noexcept
+		{
+			return _token->IsNull();
+		}
+
+		bool IsObject() const noexcept
+		{
+			return _token->GetType() == ParseToken::TokenType::TapeObject;
+		}
+
+		bool IsArray() const noexcept
+		{
+			return _token->GetType() == ParseToken::TokenType::TapeArray;
+		}
+
+		bool IsBoolean() const noexcept
+		{
+			return _token->IsBoolean();
+		}
+
+		bool IsInteger() const noexcept
+		{
+			return _token->IsInteger();
+		}
+
+		bool IsUnsignedInteger() const
+		{
+			return _token->IsUnsignedInteger();
+		}
+
+		bool IsFloatingPoint() const noexcept
+		{
+			return _token->IsFloatingPoint();
+		}
+
+		bool IsString() const noexcept
+		{
+			return _token->GetType() == ParseToken::TokenType::ParseString;
+		}
+
+		StringView AsText() const
+		{
+			return _token->AsText();
+		}
+
+		// Numbers, booleans and strings read exactly as they do from a ParseToken
+		template<typename ValueType_>
+		typename std::enable_if<
+			!std::is_same<ValueType_, TapeObject>::value &&
+			!std::is_same<ValueType_, TapeArray>::value,
+			ValueType_>::type As() const
+		{
+			return _token->As<ValueType_>();
+		}
+
+		// Containers are returned as lightweight views onto the tape
+		template<typename ValueType_>
+		typename std::enable_if<
+			std::is_same<ValueType_, TapeObject>::value,
+			ValueType_>::type As() const
+		{
+			if (!IsObject())
+				throw std::bad_cast();
+			return ValueType_(_token);
+		}
+
+		template<typename ValueType_>
+		typename std::enable_if<
+			std::is_same<ValueType_, TapeArray>::value,
+			ValueType_>::type As() const
+		{
+			if (!IsArray())
+				throw std::bad_cast();
+			return ValueType_(_token);
+		}
+	};
+
+	// The members of an object in document order.
+	// Names aren't required to be unique; like ParseObject, lookup finds the first member with a name.
+
+	class TapeObject
+	{
+		const ParseToken* _header;
+	public:
+		explicit constexpr TapeObject(const ParseToken* header) noexcept : _header(header) {}
+
+		class const_iterator
+		{
+			const ParseToken* _at; // The name of the current member
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = std::pair<StringView, TapeValue>;
+			using difference_type = std::ptrdiff_t;
+			using pointer = void;
+			using reference = value_type;
+
+			explicit constexpr const_iterator(const ParseToken* at) noexcept : _at(at) {}
+			value_type operator*() const
+			{
+				return value_type(_at->As<StringView>(), TapeValue(_at + 1));
+			}
+			const_iterator& operator++() noexcept
+			{
+				_at += 1 + TapeValue::Skip(_at + 1);
+				return *this;
+			}
+			const_iterator operator++(int) noexcept
+			{
+				auto previous = *this;
+				++*this;
+				return previous;
+			}
+			bool operator==(const const_iterator& rhs) const noexcept
+			{
+				return _at == rhs._at;
+			}
+			bool operator!=(const const_iterator& rhs) const noexcept
+			{
+				return _at != rhs._at;
+			}
+		};
+
+		std::size_t size() const noexcept
+		{
+			return TapeValue::Count(_header);
+		}
+		bool empty() const noexcept
+		{
+			return size() == 0;
+		}
+		const_iterator begin() const noexcept
+		{
+			return const_iterator(_header + 1);
+		}
+		const_iterator end() const noexcept
+		{
+			return const_iterator(_header + TapeValue::Skip(_header));
+		}
+
+		const_iterator find(StringView name) const
+		{
+			auto last = end();
+			for (auto member = begin(); member != last; ++member)
+				if ((*member).first == name)
+					return member;
+			return last;
+		}
+
+		TapeValue operator[](StringView name) const
+		{
+			auto found = find(name);
+			if (found == end())
+				throw std::out_of_range("No object member with this name");
+			return (*found).second;
+		}
+	};
+
+	// The elements of an array in document order
+
+	class TapeArray
+	{
+		const ParseToken* _header;
+	public:
+		explicit constexpr TapeArray(const ParseToken* header) noexcept : _header(header) {}
+
+		class const_iterator
+		{
+			const ParseToken* _at;
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = TapeValue;
+			using difference_type = std::ptrdiff_t;
+			using pointer = void;
+			using reference = value_type;
+
+			explicit constexpr const_iterator(const ParseToken* at) noexcept : _at(at) {}
+			value_type operator*() const noexcept
+			{
+				return TapeValue(_at);
+			}
+			const_iterator& operator++() noexcept
+			{
+				_at += TapeValue::Skip(_at);
+				return *this;
+			}
+			const_iterator operator++(int) noexcept
+			{
+				auto previous = *this;
+				++*this;
+				return previous;
+			}
+			bool operator==(const const_iterator& rhs) const noexcept
+			{
+				return _at == rhs._at;
+			}
+			bool operator!=(const const_iterator& rhs) const noexcept
+			{
+				return _at != rhs._at;
+			}
+		};
+
+		std::size_t size() const noexcept
+		{
+			return TapeValue::Count(_header);
+		}
+		bool empty() const noexcept
+		{
+			return size() == 0;
+		}
+		const_iterator begin() const noexcept
+		{
+			return const_iterator(_header + 1);
+		}
+		const_iterator end() const noexcept
+		{
+			return const_iterator(_header + TapeValue::Skip(_header));
+		}
+
+		// Direct where no element is an object or array, so each is one token. Otherwise the preceding elements are
+		// stepped over, making this for occasional access only, and indexing every element in turn quadratic.
+		TapeValue operator[](std::size_t index) const
+		{
+			if (index >= size())
+				throw std::out_of_range("Array index out of range");
+			if (TapeValue::Skip(_header) == size() + 1)
+				return TapeValue(_header + 1 + index);
+			auto element = begin();
+			while (index--)
+				++element;
+			return *element;
+		}
+	};
+
+	// Parsing happens during construct, with the same requirements on the buffer as ParseDocument.
+	// The document itself is the root value.
+
+	class TapeDocument : public TapeValue
+	{
+		// We never copy or move
+		void operator=(const TapeDocument&) = delete;
+		void operator=(const TapeDocument&&) = delete;
+		TapeDocument(const TapeDocument&) = delete;
+		TapeDocument(const TapeDocument&&) = delete;
+
+		// Enough for a small document without any reallocation
+		static constexpr std::size_t DefaultTapeSize = 64;
+
+		std::vector<ParseToken> _tape;
+		ParseOptions _options;
+
+		ParseToken ParseScalar(Character character, ParseIterator& iterator)
+		{
+			switch (character)
+			{
+			case ParseNull::FirstCharacter:
+				return ParseNull::Parse(iterator);
+
+			case ParseString::Quotes:
+				return ParseString::Parse(iterator);
+
+			case ParseBoolean::FirstTrueCharacter:
+				return ParseBoolean::ParseTrue(iterator);
+
+			case ParseBoolean::FirstFalseCharacter:
+				return ParseBoolean::ParseFalse(iterator);
+
+			default:
+				if (_options & ParseOptions::LazyNumbers)
+					return ParseNumber::ParseText(character, iterator);
+				return ParseNumber::Parse(character, iterator);
+			}
+		}
+
+		// Containers have their header written once their extent is known
+		void ParseValue(Character character, ParseIterator& iterator)
+		{
+			auto object = character == ParseObject::OpeningBraces;
+			if (!object && character != ParseArray::OpeningBracket)
+			{
+				_tape.emplace_back(ParseScalar(character, iterator));
+				return;
+			}
+
+			auto header = _tape.size();
+			_tape.emplace_back();
+			std::size_t count = 0;
+			if (object)
+				ParseGrammar::Object(iterator, ParseGrammar::InPlaceNames(), [&](StringView name, Character next, ParseIterator& at)
+				{
+					_tape.emplace_back(name.data(), name.size());
+					ParseValue(next, at);
+					count++;
+				});
+			else
+				ParseGrammar::Array(iterator, [&](Character next, ParseIterator& at)
+				{
+					ParseValue(next, at);
+					count++;
+				});
+			_tape[header] = ParseToken(object ? ParseToken::TapeContainer::Object : ParseToken::TapeContainer::Array, count, _tape.size() - header);
+		}
+	public:
+		// The JSON source must be mutable and zero terminated
+		// Note that this constructor doesn't persist the buffer, and it needs to live as long as this instance
+		explicit TapeDocument(ParseIterator iterator, ParseOptions options = ParseOptions::None) :
+			TapeValue(nullptr),
+			_options(options)
+		{
+			_tape.reserve(DefaultTapeSize);
+			ParseGrammar::Document(iterator, [this](Character next, ParseIterator& at)
+			{
+				ParseValue(next, at);
+			});
+			_token = _tape.data();
+		}
+
+		// The number of tokens in the document, including container headers and member names
+		std::size_t TapeSize() const noexcept
+		{
+			return _tape.size();
+		}
+	};
+
+}
@@ -1,16 +1,20 @@
 #pragma once
 #include <string_view>
 #include <typeinfo> // bad_cast
-#include <map>
 #include <vector>
+#include <memory_resource>
 #include <type_traits>
+#include <limits>
+#include <cstdint>
 #include "Parse.hpp"
+#include "ParseMembers.hpp"
 
 namespace August
 {
 	class ParseArray;
 	class ParseObject;
 	class ParseString;
+	class TapeValue;
 
 	// A token representing one of the several types.
 	// The type of any token can only be tested at runtime.
@@ -26,28 +30,41 @@ namespace August
 			BooleanTrue,
 			BooleanFalse,
 			Integer,
-			FloatingPoint
+			FloatingPoint,
+			UnsignedInteger, // Only used for integers too large for std::int64_t
+			IntegerText, // Unconverted numbers kept by ParseOptions::LazyNumbers
+			FloatingPointText,
+			TapeObject, // Containers within a TapeDocument
+			TapeArray,
+			EscapedString, // A string of a read only document that's yet to be decoded
+			PackedIntegers, // Arrays packed by ParseOptions::PackedNumbers
+			PackedFloatingPoints,
+			TypeCount // Not a type, only kept last for checking they all fit in TypeBits
 		};
 
 		union FloatingPointIntegerOrPointer
 		{
 			constexpr explicit FloatingPointIntegerOrPointer(double floatingPoint) noexcept : _floatingPoint(floatingPoint) {}
 			constexpr explicit FloatingPointIntegerOrPointer(std::int64_t integer) noexcept : _integer(integer) {}
+			constexpr explicit FloatingPointIntegerOrPointer(std::uint64_t unsignedInteger) noexcept : _unsignedInteger(unsignedInteger) {}
 			constexpr explicit FloatingPointIntegerOrPointer(const void* pointer) noexcept : _pointer(pointer) {}
 
 			double _floatingPoint;
 			std::int64_t _integer;
+			std::uint64_t _unsignedInteger;
 			const void* _pointer;
 		};
 		FloatingPointIntegerOrPointer _data;
 		std::size_t _index; // ParseObject index, array index or string length combined with token type
+		static constexpr unsigned TypeBits = 4;
+		static_assert(static_cast<unsigned>(TokenType::TypeCount) <= (1u << TypeBits), "Every token type needs to fit in TypeBits");
 		constexpr TokenType GetType() const noexcept
 		{
-			return static_cast<TokenType>(_index & 0x7);
+			return static_cast<TokenType>(_index & ((1u << TypeBits) - 1));
 		}
 		constexpr std::size_t GetIndex() const noexcept
 		{
-			return _index >> 3;
+			return _index >> TypeBits;
 		}
 		constexpr std::size_t MakeIndex(TokenType type) const noexcept
 		{
@@ -55,9 +72,54 @@ namespace August
 		}
 		constexpr std::size_t MakeIndex(TokenType type, std::size_t index) const noexcept
 		{
-			return (index << 3) | MakeIndex(type);
+			return (index << TypeBits) | MakeIndex(type);
+		}
+		bool IsNumberText() const noexcept
+		{
+			return GetType() == TokenType::IntegerText || GetType() == TokenType::FloatingPointText;
+		}
+		ParseToken ConvertNumberText() const
+		{
+			return ParseNumberText(static_cast<const Character*>(_data._pointer));
+		}
+		const NumbersTable::Run& PackedRun() const noexcept
+		{
+			return static_cast<const NumbersTable*>(_data._pointer)->Arrays[GetIndex()];
+		}
+
+		// Tokens for the elements of a packed array, made when first read as a ParseArray
+		const std::pmr::vector<ParseToken>& PackedElements() const
+		{
+			auto& numbers = *static_cast<const NumbersTable*>(_data._pointer);
+			auto& run = PackedRun();
+			std::lock_guard<std::mutex> lock(numbers.Lock);
+			auto& elements = numbers.Elements[GetIndex()];
+			if (elements.empty())
+			{
+				elements.reserve(run.Count);
+				for (auto offset = run.Offset; offset < run.Offset + run.Count; offset++)
+				{
+					if (GetType() == TokenType::PackedIntegers)
+						elements.emplace_back(numbers.Integers[offset]);
+					else
+						elements.emplace_back(numbers.FloatingPoints[offset]);
+				}
+			}
+			return elements;
 		}
+
+		// Tape containers are only interpreted by TapeValue
+		friend class TapeValue;
 	public:
+		// Whether unconverted number text is an integer or floating point number, as the regular parse would have it
+		enum class NumberText
+		{
+			Integer,
+			FloatingPoint
+		};
+		// Integer text shorter than this, including any sign, always fits std::int64_t, so needs no conversion to classify
+		static constexpr std::size_t ShortIntegerText = 19;
+
 #ifdef _MSC_VER
 #pragma warning(push)
 #pragma warning(disable : 26495) // Uninitialised members is okay - they're never used.
@@ -85,11 +147,37 @@ namespace August
 			_index(MakeIndex(TokenType::Integer))
 		{
 		}
+		explicit constexpr ParseToken(std::uint64_t unsignedInteger) noexcept :
+			_data(unsignedInteger),
+			_index(MakeIndex(TokenType::UnsignedInteger))
+		{
+		}
 		constexpr ParseToken(const Character* string, std::size_t stringLength) noexcept :
 			_data(static_cast<const void*>(string)),
 			_index(MakeIndex(TokenType::ParseString, stringLength))
 		{
 		}
+		constexpr ParseToken(NumberText form, const Character* text, std::size_t textLength) noexcept :
+			_data(static_cast<const void*>(text)),
+			_index(MakeIndex(form == NumberText::Integer ? TokenType::IntegerText : TokenType::FloatingPointText, textLength))
+		{
+		}
+		explicit constexpr ParseToken(const August::EscapedString* escaped) noexcept :
+			_data(static_cast<const void*>(escaped)),
+			_index(MakeIndex(TokenType::EscapedString))
+		{
+		}
+		// A container within a TapeDocument, followed on the tape by its members or elements
+		enum class TapeContainer
+		{
+			Object,
+			Array
+		};
+		constexpr ParseToken(TapeContainer container, std::size_t count, std::size_t skip) noexcept :
+			_data(static_cast<std::uint64_t>(skip)),
+			_index(MakeIndex(container == TapeContainer::Object ? TokenType::TapeObject : TokenType::TapeArray, count))
+		{
+		}
 		constexpr ParseToken(const ArraysTable* arrays, std::size_t index) noexcept : 
 			_data(static_cast<const void*>(arrays)),
 			_index(MakeIndex(TokenType::ParseArray, index))
@@ -100,6 +188,17 @@ namespace August
 			_index(MakeIndex(TokenType::ParseObject, index))
 		{
 		}
+		// An array packed by ParseOptions::PackedNumbers, by the index of its run
+		enum class Packed
+		{
+			Integers,
+			FloatingPoints
+		};
+		constexpr ParseToken(Packed packed, const NumbersTable* numbers, std::size_t index) noexcept :
+			_data(static_cast<const void*>(numbers)),
+			_index(MakeIndex(packed == Packed::Integers ? TokenType::PackedIntegers : TokenType::PackedFloatingPoints, index))
+		{
+		}
 		explicit constexpr ParseToken(const ParseToken& rhs) noexcept : 
 			_data(rhs._data),
 			_index(rhs._index)
@@ -133,9 +232,30 @@ namespace August
 			return GetType() == TokenType::ParseObject;
 		}
 
+		// Including those packed by ParseOptions::PackedNumbers
 		bool IsArray() const noexcept
 		{
-			return GetType() == TokenType::ParseArray;
+			return GetType() == TokenType::ParseArray || IsPacked();
+		}
+		// An array packed by ParseOptions::PackedNumbers
+		bool IsPacked() const noexcept
+		{
+			return GetType() == TokenType::PackedIntegers || GetType() == TokenType::PackedFloatingPoints;
+		}
+		// Whether this array's elements can be read together with As<PackedNumbers<std::int64_t>>()
+		bool IsPackedIntegers() const noexcept
+		{
+			return GetType() == TokenType::PackedIntegers;
+		}
+		// Whether this array's elements can be read together with As<PackedNumbers<double>>()
+		bool IsPackedFloatingPoints() const noexcept
+		{
+			return GetType() == TokenType::PackedFloatingPoints;
+		}
+
+		bool IsString() const noexcept
+		{
+			return GetType() == TokenType::ParseString || GetType() == TokenType::EscapedString;
 		}
 
 		bool IsBoolean() const noexcept
@@ -143,14 +263,33 @@ namespace August
 			return GetType() == TokenType::BooleanTrue || GetType() == TokenType::BooleanFalse;
 		}
 
+		// Readable as std::int64_t, so not those only readable as unsigned
 		bool IsInteger() const noexcept
 		{
+			if (GetType() == TokenType::IntegerText)
+				return GetIndex() < ShortIntegerText || ConvertNumberText().IsInteger();
 			return GetType() == TokenType::Integer;
 		}
 
+		// An integer above the range of std::int64_t, only readable as an unsigned or floating point type, and not IsInteger()
+		bool IsUnsignedInteger() const
+		{
+			if (GetType() == TokenType::IntegerText)
+				return ConvertNumberText().IsUnsignedInteger();
+			return GetType() == TokenType::UnsignedInteger;
+		}
+
 		bool IsFloatingPoint() const noexcept
 		{
-			return GetType() == TokenType::FloatingPoint;
+			return GetType() == TokenType::FloatingPoint || GetType() == TokenType::FloatingPointText;
+		}
+
+		// The original text of a number parsed with ParseOptions::LazyNumbers, for values beyond the range or precision of the native types
+		StringView AsText() const
+		{
+			if (!IsNumberText())
+				throw std::bad_cast();
+			return StringView(static_cast<const Character*>(_data._pointer), GetIndex());
 		}
 
 		template<typename ValueType_>
@@ -160,13 +299,17 @@ namespace August
 			ValueType_>::type As() const
 		{
 			auto type = GetType();
-			if (type != TokenType::Integer)
-			{
-				// If the file provides a floating point number, and you're expecting an integer, 
-				// that's an error in the same way as other incorrect type
-				throw std::bad_cast();
-			}
-			return static_cast<ValueType_>(_data._integer);
+			if (type == TokenType::Integer)
+				return static_cast<ValueType_>(_data._integer);
+			if (type == TokenType::IntegerText)
+				return ConvertNumberText().As<ValueType_>();
+			if (type == TokenType::UnsignedInteger && !std::numeric_limits<ValueType_>::is_signed)
+				return static_cast<ValueType_>(_data._unsignedInteger);
+
+			// If the file provides a floating point number, and you're expecting an integer, 
+			// that's an error in the same way as other incorrect type.
+			// Likewise an integer too large for any signed type.
+			throw std::bad_cast();
 		}
 
 		template<typename ValueType_>
@@ -177,11 +320,15 @@ namespace August
 			auto type = GetType();
 			if (type == TokenType::FloatingPoint)
 				return static_cast<ValueType_>(_data._floatingPoint);
+			if (IsNumberText())
+				return ConvertNumberText().As<ValueType_>();
 			if (type == TokenType::Integer)
 			{
 				// Integer can be promoted to floating point
 				return static_cast<ValueType_>(_data._integer);
 			}
+			if (type == TokenType::UnsignedInteger)
+				return static_cast<ValueType_>(_data._unsignedInteger);
 			throw std::bad_cast();
 		}
 
@@ -205,6 +352,11 @@ namespace August
 			ValueType_>::type As() const
 		{
 			auto type = GetType();
+			if (type == TokenType::EscapedString)
+			{
+				auto text = ParseEscapedText(*static_cast<const August::EscapedString*>(_data._pointer));
+				return ValueType_(text.data(), text.size());
+			}
 			if (type != TokenType::ParseString)
 				throw std::bad_cast();
 			return ValueType_(static_cast<const Character*>(_data._pointer), GetIndex());
@@ -213,19 +365,44 @@ namespace August
 		template<typename ValueType_>
 		typename std::enable_if<
 			std::is_same<ValueType_, ParseArray>::value ||
-			std::is_same<ValueType_, std::vector<ParseToken>>::value,
+			std::is_same<ValueType_, std::pmr::vector<ParseToken>>::value,
 			const ValueType_&>::type As() const
 		{
 			auto type = GetType();
+			if (IsPacked())
+				return static_cast<const ValueType_&>(PackedElements());
 			if (type != TokenType::ParseArray)
 				throw std::bad_cast();
 			return static_cast<const ValueType_&>((*static_cast<const ArraysTable*>(_data._pointer))[GetIndex()]);
 		}
 
+		// The elements of an array packed by ParseOptions::PackedNumbers, without making a token for each
+		template<typename ValueType_>
+		typename std::enable_if<
+			std::is_same<ValueType_, PackedNumbers<std::int64_t>>::value,
+			ValueType_>::type As() const
+		{
+			if (GetType() != TokenType::PackedIntegers)
+				throw std::bad_cast();
+			auto& run = PackedRun();
+			return ValueType_(static_cast<const NumbersTable*>(_data._pointer)->Integers.data() + run.Offset, run.Count);
+		}
+
+		template<typename ValueType_>
+		typename std::enable_if<
+			std::is_same<ValueType_, PackedNumbers<double>>::value,
+			ValueType_>::type As() const
+		{
+			if (GetType() != TokenType::PackedFloatingPoints)
+				throw std::bad_cast();
+			auto& run = PackedRun();
+			return ValueType_(static_cast<const NumbersTable*>(_data._pointer)->FloatingPoints.data() + run.Offset, run.Count);
+		}
+
 		template<typename ValueType_>
 		typename std::enable_if<
 			std::is_same<ValueType_, ParseObject>::value ||
-			std::is_same<ValueType_, std::map<StringView, ParseToken>>::value,
+			std::is_same<ValueType_, ObjectMembers<ParseToken>>::value,
 			const ValueType_&>::type As() const
 		{
 			auto type = GetType();